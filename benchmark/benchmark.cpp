@@ -1,28 +1,69 @@
 #include <benchmark/benchmark.h>
 #include "galileo.h"
-#include "../external/type_map/include/type_map.hpp"
 
-#include <complex>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
 #include <memory>
+#include <new>
+#include <optional>
+#include <string>
+
+#define UNARY_OPS(X) \
+	X(Abs) X(Acos) X(Acosh) X(Asin) X(Asinh) X(Atan) X(Atanh) X(Conj) X(Cos) X(Cosh) \
+	X(Erf) X(Exp) X(Log) X(Neg) X(Sign) X(Sin) X(Sinh) X(Sqrt) X(Tan) X(Tanh)
+#define BINARY_OPS(X) \
+	X(Add) X(Div) X(Mul) X(Sub)
+#define OP_ENTRY(NAME) { #NAME, GALILEO_ ## NAME },
 
 namespace helper {
-	using type_map = mk::TypeMap<
-		mk::TypeValuePair<std::uint8_t, GALILEO_DATA_TYPE::GALILEO_UINT8>,
-		mk::TypeValuePair<std::uint16_t, GALILEO_DATA_TYPE::GALILEO_UINT16>,
-		mk::TypeValuePair<std::uint32_t, GALILEO_DATA_TYPE::GALILEO_UINT32>,
-		mk::TypeValuePair<std::uint64_t, GALILEO_DATA_TYPE::GALILEO_UINT64>,
-		mk::TypeValuePair<std::int8_t, GALILEO_DATA_TYPE::GALILEO_INT8>,
-		mk::TypeValuePair<std::int16_t, GALILEO_DATA_TYPE::GALILEO_INT16>,
-		mk::TypeValuePair<std::int32_t, GALILEO_DATA_TYPE::GALILEO_INT32>,
-		mk::TypeValuePair<std::int64_t, GALILEO_DATA_TYPE::GALILEO_INT64>,
-		mk::TypeValuePair<float, GALILEO_DATA_TYPE::GALILEO_FLOAT>,
-		mk::TypeValuePair<double, GALILEO_DATA_TYPE::GALILEO_DOUBLE>,
-		//mk::TypeValuePair<std::uint8_t, GALILEO_DATA_TYPE::GALILEO_HALF>,
-		//mk::TypeValuePair<std::uint8_t, GALILEO_DATA_TYPE::GALILEO_BFLOAT16>,
-		mk::TypeValuePair<std::complex<float>, GALILEO_DATA_TYPE::GALILEO_COMPLEX_FLOAT>,
-		mk::TypeValuePair<std::complex<double>, GALILEO_DATA_TYPE::GALILEO_COMPLEX_DOUBLE>
-		//mk::TypeValuePair<std::uint8_t, GALILEO_DATA_TYPE::GALILEO_COMPLEX_HALF>
-	>;
+	struct DataType {
+		GALILEO_DATA_TYPE data_type;
+		const char* name;
+		std::size_t size;
+	};
+
+	constexpr std::array data_types = {
+		DataType{ GALILEO_UINT8, "uint8", 1 },
+		DataType{ GALILEO_UINT16, "uint16", 2 },
+		DataType{ GALILEO_UINT32, "uint32", 4 },
+		DataType{ GALILEO_UINT64, "uint64", 8 },
+		DataType{ GALILEO_INT8, "int8", 1 },
+		DataType{ GALILEO_INT16, "int16", 2 },
+		DataType{ GALILEO_INT32, "int32", 4 },
+		DataType{ GALILEO_INT64, "int64", 8 },
+		DataType{ GALILEO_FLOAT, "float", 4 },
+		DataType{ GALILEO_DOUBLE, "double", 8 },
+		DataType{ GALILEO_HALF, "half", 2 },
+		DataType{ GALILEO_COMPLEX_FLOAT, "complex_float", 8 },
+		DataType{ GALILEO_COMPLEX_DOUBLE, "complex_double", 16 },
+		DataType{ GALILEO_COMPLEX_HALF, "complex_half", 4 },
+		DataType{ GALILEO_BFLOAT16, "bfloat16", 2 }
+	};
+
+	using UnaryFunction = GALILEO_RESULT(*)(const GALILEO_TENSOR*, GALILEO_TENSOR*);
+	using BinaryFunction = GALILEO_RESULT(*)(const GALILEO_TENSOR*, const GALILEO_TENSOR*, GALILEO_TENSOR*);
+
+	template <typename Function>
+	struct Op {
+		const char* name;
+		Function function;
+	};
+
+	constexpr Op<UnaryFunction> unary_ops[] = { UNARY_OPS(OP_ENTRY) };
+	constexpr Op<BinaryFunction> binary_ops[] = { BINARY_OPS(OP_ENTRY) };
+
+	// latency runs are dominated by the submission and synchronization, throughput runs by the memory bandwidth
+	struct Scenario {
+		const char* name;
+		unsigned int size;
+	};
+
+	constexpr Scenario scenarios[] = {
+		{ "latency", 1 << 10 },
+		{ "throughput", 1 << 22 }
+	};
 
 	auto GetQueue() {
 		unsigned int queue_size = 0;
@@ -34,47 +75,137 @@ namespace helper {
 		return queue_ptr;
 	}
 
-	template <typename T>
-	auto GetTensor(const GALILEO_QUEUE& queue, std::size_t size) {
-		void* ptr = nullptr;
-		GALILEO_Allocate(queue, type_map::GetValueByType<T>(), size, &ptr);
-
-		auto deleter = [queue](GALILEO_TENSOR* tensor) {
-			return GALILEO_Deallocate(queue, tensor->tensor_data);
-		};
-		auto tensor = std::unique_ptr<GALILEO_TENSOR, decltype(deleter)>(new GALILEO_TENSOR(), deleter);
-		GALILEO_Create1dTensor(queue, ptr, type_map::GetValueByType<T>(), size, tensor.get());
-		return tensor;
+	// every benchmark shares the queue, so that the kernels are built once
+	GALILEO_QUEUE queue = nullptr;
+
+	// ones are in the domain of every op and keep the integer division defined
+	class Tensor {
+		GALILEO_TENSOR tensor{};
+
+	public:
+		Tensor(const DataType& type, unsigned int size) {
+			void* ptr = nullptr;
+			if (GALILEO_Allocate(queue, type.data_type, size, &ptr) != GALILEO_RESULT_OK)
+				throw std::bad_alloc();
+			GALILEO_Create1dTensor(queue, ptr, type.data_type, size, &tensor);
+
+			void* ones = nullptr;
+			if (GALILEO_Allocate(queue, GALILEO_FLOAT, size, &ones) != GALILEO_RESULT_OK)
+				throw std::bad_alloc();
+			std::fill_n(static_cast<float*>(ones), size, 1.f);
+			GALILEO_TENSOR ones_tensor{};
+			GALILEO_Create1dTensor(queue, ones, GALILEO_FLOAT, size, &ones_tensor);
+			// types the cast isn't built for get non-zero bytes instead
+			if (GALILEO_Cast(&ones_tensor, &tensor, GALILEO_ROUNDING_NEAREST_EVEN, 0) != GALILEO_RESULT_OK)
+				std::memset(ptr, 1, size * type.size);
+			GALILEO_QueueWait(queue);
+			GALILEO_Deallocate(queue, ones);
+		}
+
+		Tensor(const Tensor&) = delete;
+		Tensor& operator=(const Tensor&) = delete;
+
+		~Tensor() {
+			GALILEO_Deallocate(queue, tensor.tensor_data);
+		}
+
+		GALILEO_TENSOR* get() {
+			return &tensor;
+		}
+	};
+
+	// every iteration waits for the op, so that the execution is measured and not only the submission
+	template <typename Call>
+	void Run(benchmark::State& state, Call call, std::size_t bytes_per_element) {
+		const auto size = static_cast<std::size_t>(state.range(0));
+		for (auto _ : state) {
+			const auto result = call();
+			GALILEO_QueueWait(queue);
+			if (result != GALILEO_RESULT_OK) {
+				state.SkipWithError(("GALILEO_RESULT " + std::to_string(result)).c_str());
+				break;
+			}
+		}
+		state.SetItemsProcessed(state.iterations() * size);
+		state.SetBytesProcessed(state.iterations() * size * bytes_per_element);
+	}
+
+	// a short run of each combination tells the unsupported ones apart and builds the kernels ahead of the measurements
+	template <typename Call>
+	bool IsSupported(Call call) {
+		const auto result = call();
+		GALILEO_QueueWait(queue);
+		return result == GALILEO_RESULT_OK;
 	}
-}
-#include <iostream>
-#define UNARY_BENCHMARK_OPTIONS RangeMultiplier(2)->Range(16, 2048 << 6)->Complexity()
-template <typename T, typename U>
-static void ExpBenchmark(benchmark::State& state) {
-	auto queue = helper::GetQueue();
-	auto input = helper::GetTensor<T>(queue.get(), state.range());
-	auto output = helper::GetTensor<U>(queue.get(), state.range());
-    for (auto _ : state) {
-		auto result = GALILEO_Exp(input.get(), output.get());
-		if (result != GALILEO_RESULT_OK) {
-			std::cout << "!!!!!!!!!!!!" << (int)result << std::endl;
-			//throw std::runtime_error("Oops");
-			break;
+
+	constexpr unsigned int probe_size = 16;
+
+	void RegisterUnary(const Op<UnaryFunction>& op, const DataType& type) {
+		{
+			Tensor input(type, probe_size);
+			Tensor output(type, probe_size);
+			if (!IsSupported([&] { return op.function(input.get(), output.get()); }))
+				return;
+		}
+
+		for (const auto& scenario : scenarios) {
+			const auto name = std::string("Unary/") + op.name + "/" + type.name + "/" + scenario.name;
+			benchmark::RegisterBenchmark(name.c_str(), [&op, &type](benchmark::State& state) {
+				const auto size = static_cast<unsigned int>(state.range(0));
+				Tensor input(type, size);
+				Tensor output(type, size);
+				Run(state, [&] { return op.function(input.get(), output.get()); }, 2 * type.size);
+				})->Arg(scenario.size)->UseRealTime();
+		}
+	}
+
+	// the output type follows from the promotion of the input types
+	std::optional<DataType> GetBinaryOutputType(const Op<BinaryFunction>& op, const DataType& lhs, const DataType& rhs) {
+		Tensor input_lhs(lhs, probe_size);
+		Tensor input_rhs(rhs, probe_size);
+		for (const auto& type : data_types) {
+			Tensor output(type, probe_size);
+			if (IsSupported([&] { return op.function(input_lhs.get(), input_rhs.get(), output.get()); }))
+				return type;
+		}
+		return std::nullopt;
+	}
+
+	void RegisterBinary(const Op<BinaryFunction>& op, const DataType& lhs, const DataType& rhs) {
+		const auto output_type = GetBinaryOutputType(op, lhs, rhs);
+		if (!output_type)
+			return;
+
+		for (const auto& scenario : scenarios) {
+			const auto name = std::string("Binary/") + op.name + "/" + lhs.name + "_" + rhs.name + "/" + scenario.name;
+			benchmark::RegisterBenchmark(name.c_str(), [&op, &lhs, &rhs, output = *output_type](benchmark::State& state) {
+				const auto size = static_cast<unsigned int>(state.range(0));
+				Tensor input_lhs(lhs, size);
+				Tensor input_rhs(rhs, size);
+				Tensor output_tensor(output, size);
+				Run(state, [&] { return op.function(input_lhs.get(), input_rhs.get(), output_tensor.get()); }, lhs.size + rhs.size + output.size);
+				})->Arg(scenario.size)->UseRealTime();
 		}
-        //ugsdr::SequentialMixer::Translate(input, 100.0, 1.0);
-        //benchmark::DoNotOptimize(input);
-    }
-    state.SetComplexityN(state.range());
+	}
 }
-BENCHMARK_TEMPLATE(ExpBenchmark, float, float)->UNARY_BENCHMARK_OPTIONS;
-BENCHMARK_TEMPLATE(ExpBenchmark, int, int)->UNARY_BENCHMARK_OPTIONS;
-BENCHMARK_TEMPLATE(ExpBenchmark, double, double)->UNARY_BENCHMARK_OPTIONS;
 
+// machine-readable results for benchmark/compare.py: --benchmark_out=results.json --benchmark_out_format=json
 int main(int argc, char** argv) {
-    ::benchmark::Initialize(&argc, argv);
-    if (::benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
-    ::benchmark::RunSpecifiedBenchmarks();
-    ::benchmark::Shutdown();
-    system("pause");
-    return 0;
-}
\ No newline at end of file
+	::benchmark::Initialize(&argc, argv);
+	if (::benchmark::ReportUnrecognizedArguments(argc, argv))
+		return 1;
+
+	auto queue_ptr = helper::GetQueue();
+	helper::queue = queue_ptr.get();
+	for (const auto& op : helper::unary_ops)
+		for (const auto& type : helper::data_types)
+			helper::RegisterUnary(op, type);
+	for (const auto& op : helper::binary_ops)
+		for (const auto& lhs : helper::data_types)
+			for (const auto& rhs : helper::data_types)
+				helper::RegisterBinary(op, lhs, rhs);
+
+	::benchmark::RunSpecifiedBenchmarks();
+	::benchmark::Shutdown();
+	return 0;
+}
@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+"""Compares two JSON outputs of galileo_benchmark (--benchmark_out_format=json).
+
+    compare.py baseline.json current.json [--threshold 0.1]
+
+Prints the relative change of the real time and the bandwidth of every benchmark present in both files
+and exits with 1 when any of them got slower by more than the threshold.
+"""
+
+import argparse
+import json
+import sys
+
+TIME_UNITS = {'ns': 1.0, 'us': 1e3, 'ms': 1e6, 's': 1e9}
+
+
+def load(path):
+    with open(path) as file:
+        benchmarks = json.load(file)['benchmarks']
+    # repetitions report aggregates, the mean is compared when there are any
+    results = {}
+    for benchmark in benchmarks:
+        if benchmark.get('run_type') == 'aggregate' and benchmark.get('aggregate_name') != 'mean':
+            continue
+        name = benchmark.get('run_name', benchmark['name'])
+        if name in results and benchmark.get('run_type') != 'aggregate':
+            continue
+        results[name] = {
+            'time': benchmark['real_time'] * TIME_UNITS[benchmark.get('time_unit', 'ns')],
+            'bandwidth': benchmark.get('bytes_per_second', 0.0),
+            'error': benchmark.get('error_occurred', False),
+        }
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('baseline')
+    parser.add_argument('current')
+    parser.add_argument('--threshold', type=float, default=0.1, help='relative slowdown reported as a regression')
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+    regressions = []
+    print(f'{"benchmark":<60} {"time":>10} {"GB/s base":>10} {"GB/s now":>10}')
+    for name in sorted(baseline.keys() & current.keys()):
+        before, after = baseline[name], current[name]
+        if before['error'] or after['error']:
+            print(f'{name:<60} {"error":>10}')
+            continue
+        change = after['time'] / before['time'] - 1.0
+        print(f'{name:<60} {change:>+10.1%} {before["bandwidth"] / 1e9:>10.2f} {after["bandwidth"] / 1e9:>10.2f}')
+        if change > args.threshold:
+            regressions.append((name, change))
+
+    for name in sorted(baseline.keys() - current.keys()):
+        print(f'{name:<60} {"missing":>10}')
+    for name in sorted(current.keys() - baseline.keys()):
+        print(f'{name:<60} {"new":>10}')
+
+    if regressions:
+        print(f'\n{len(regressions)} regression(s) above {args.threshold:.0%}:')
+        for name, change in sorted(regressions, key=lambda regression: -regression[1]):
+            print(f'  {name}: {change:+.1%}')
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -23,6 +23,13 @@ int main() {
 	incorrect.tensor_data = qq;
 	GALILEO_Abs(&incorrect, &in_out_tensor);
 
+	// foreign memory is registered instead
+	GALILEO_RegisterHostMemory(queue_ptr.get(), qq, sizeof(qq), nullptr);
+	auto foreign_tensor = GALILEO_TENSOR();
+	GALILEO_Create1dTensor(queue_ptr.get(), qq, GALILEO_FLOAT, 1024, &foreign_tensor);
+	GALILEO_Abs(&foreign_tensor, &foreign_tensor);
+	GALILEO_UnregisterHostMemory(queue_ptr.get(), qq);
+
 	GALILEO_Deallocate(queue_ptr.get(), ptr);
 
 	GALILEO_ReleaseQueue(queue_ptr.get());
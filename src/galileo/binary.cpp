@@ -1,28 +1,30 @@
 #include "common.hpp"
+#include "context.hpp"
 #include "binary.hpp"
 
-#define BINARY_BINARY_ELTWISE_FUNCTION_DEF(EXT_NAME, KERNEL_NAME) GALILEO_RESULT EXT_NAME(const GALILEO_TENSOR* input_lhs, const GALILEO_TENSOR* input_rhs, GALILEO_TENSOR* output) { \
+#define BINARY_BINARY_ELTWISE_FUNCTION_DEF(EXT_NAME, ASYNC_EXT_NAME, KERNEL_NAME) GALILEO_RESULT ASYNC_EXT_NAME(const GALILEO_TENSOR* input_lhs, const GALILEO_TENSOR* input_rhs, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event) { \
 	try { \
+		const auto profile_start = galileo::common::ProfileClock::now(); \
 		if (!input_lhs || !input_rhs || !output || !input_lhs->tensor_data || !input_rhs->tensor_data || !output->tensor_data) \
 			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER; \
 	 \
 		if (!galileo::common::VerifyQueryPtrs(*input_lhs, *input_rhs, *output)) \
 			return GALILEO_RESULT::GALILEO_RESULT_TENSOR_QUEUE_MISMATCH; \
 	 \
-		if (!galileo::common::VerifyDimensionsPtrs(*input_lhs, *input_rhs, *output)) \
+		if (!galileo::common::VerifyBroadcastDimensions(*input_lhs, *input_rhs, *output) || !galileo::common::IsWritable(output->dimensions)) \
 			return GALILEO_RESULT::GALILEO_RESULT_TENSOR_DIMENSIONS_MISMATCH; \
 	 \
 		auto queue = input_lhs->associated_queue; \
 	 \
-		const auto input_lhs_ptr_state = galileo::common::VerifyPtr(galileo::common::GetQueue(queue), input_lhs->tensor_data); \
-		const auto input_rhs_ptr_state = galileo::common::VerifyPtr(galileo::common::GetQueue(queue), input_rhs->tensor_data); \
-		const auto output_ptr_state = galileo::common::VerifyPtr(galileo::common::GetQueue(queue), output->tensor_data); \
+		const auto input_lhs_ptr_state = galileo::common::VerifyTensor(*input_lhs); \
+		const auto input_rhs_ptr_state = galileo::common::VerifyTensor(*input_rhs); \
+		const auto output_ptr_state = galileo::common::VerifyTensor(*output); \
 		if (!input_lhs_ptr_state || !input_rhs_ptr_state || !output_ptr_state) \
 			return GALILEO_RESULT_NON_USM_POINTER; \
 	\
-		auto kernel = KERNEL_NAME(*input_lhs, *input_rhs, *output); \
-		auto& typed_queue = galileo::common::GetQueue(queue); \
-		typed_queue.submit(kernel); \
+		auto dependencies = galileo::common::GetEvents(wait_events, wait_events_size); \
+		auto make_kernel = [](GALILEO_TENSOR* tensors) { return KERNEL_NAME(tensors[0], tensors[1], tensors[2]); }; \
+		galileo::common::SetEvent(event, galileo::common::ProfileOp(queue, #KERNEL_NAME, profile_start, std::array{ *input_lhs, *input_rhs, *output }, [&](const auto& op_tensors) { return galileo::common::SubmitElementwiseOp(queue, op_tensors, make_kernel, dependencies); })); \
 	} \
 	catch (GALILEO_RESULT res) { \
 		return res; \
@@ -31,11 +33,95 @@
 		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR; \
 	} \
 	return GALILEO_RESULT::GALILEO_RESULT_OK; \
+} \
+GALILEO_RESULT EXT_NAME(const GALILEO_TENSOR* input_lhs, const GALILEO_TENSOR* input_rhs, GALILEO_TENSOR* output) { \
+	return ASYNC_EXT_NAME(input_lhs, input_rhs, output, nullptr, 0, nullptr); \
 }
 #define CREATE_EXT_NAME( s ) GALILEO_ ## s
-#define BINARY_ELTWISE_FUNCTION(NAME) BINARY_BINARY_ELTWISE_FUNCTION_DEF(CREATE_EXT_NAME(NAME), NAME)
+#define CREATE_ASYNC_EXT_NAME( s ) GALILEO_ ## s ## Async
+#define BINARY_ELTWISE_FUNCTION(NAME) BINARY_BINARY_ELTWISE_FUNCTION_DEF(CREATE_EXT_NAME(NAME), CREATE_ASYNC_EXT_NAME(NAME), NAME)
 
 BINARY_ELTWISE_FUNCTION(Add)
 BINARY_ELTWISE_FUNCTION(Div)
 BINARY_ELTWISE_FUNCTION(Mul)
-BINARY_ELTWISE_FUNCTION(Sub)
\ No newline at end of file
+BINARY_ELTWISE_FUNCTION(Sub)
+
+#define BINARY_SCALAR_FUNCTION_DEF(EXT_NAME, ASYNC_EXT_NAME, KERNEL_NAME) GALILEO_RESULT ASYNC_EXT_NAME(const GALILEO_TENSOR* input, const GALILEO_SCALAR* scalar, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event) { \
+	try { \
+		const auto profile_start = galileo::common::ProfileClock::now(); \
+		if (!input || !scalar || !output || !input->tensor_data || !output->tensor_data) \
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER; \
+	 \
+		if (!galileo::common::VerifyQueryPtrs(*input, *output)) \
+			return GALILEO_RESULT::GALILEO_RESULT_TENSOR_QUEUE_MISMATCH; \
+	 \
+		if (!galileo::common::VerifyDimensionsPtrs(*input, *output) || !galileo::common::IsWritable(output->dimensions)) \
+			return GALILEO_RESULT::GALILEO_RESULT_TENSOR_DIMENSIONS_MISMATCH; \
+	 \
+		auto queue = input->associated_queue; \
+	 \
+		const auto input_ptr_state = galileo::common::VerifyTensor(*input); \
+		const auto output_ptr_state = galileo::common::VerifyTensor(*output); \
+		if (!input_ptr_state || !output_ptr_state) \
+			return GALILEO_RESULT_NON_USM_POINTER; \
+	\
+		auto dependencies = galileo::common::GetEvents(wait_events, wait_events_size); \
+		auto make_kernel = [scalar = *scalar](GALILEO_TENSOR* tensors) { return KERNEL_NAME(tensors[0], scalar, tensors[1]); }; \
+		galileo::common::SetEvent(event, galileo::common::ProfileOp(queue, #KERNEL_NAME, profile_start, std::array{ *input, *output }, [&](const auto& op_tensors) { return galileo::common::SubmitElementwiseOp(queue, op_tensors, make_kernel, dependencies); })); \
+	} \
+	catch (GALILEO_RESULT res) { \
+		return res; \
+	} \
+	catch (...) { \
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR; \
+	} \
+	return GALILEO_RESULT::GALILEO_RESULT_OK; \
+} \
+GALILEO_RESULT EXT_NAME(const GALILEO_TENSOR* input, const GALILEO_SCALAR* scalar, GALILEO_TENSOR* output) { \
+	return ASYNC_EXT_NAME(input, scalar, output, nullptr, 0, nullptr); \
+}
+#define BINARY_SCALAR_FUNCTION(NAME) BINARY_SCALAR_FUNCTION_DEF(CREATE_EXT_NAME(NAME), CREATE_ASYNC_EXT_NAME(NAME), NAME)
+
+BINARY_SCALAR_FUNCTION(AddScalar)
+BINARY_SCALAR_FUNCTION(DivScalar)
+BINARY_SCALAR_FUNCTION(MulScalar)
+BINARY_SCALAR_FUNCTION(SubScalar)
+BINARY_SCALAR_FUNCTION(ScalarDiv)
+BINARY_SCALAR_FUNCTION(ScalarSub)
+
+GALILEO_RESULT GALILEO_AxpbyAsync(const GALILEO_SCALAR* alpha, const GALILEO_TENSOR* x, const GALILEO_SCALAR* beta, const GALILEO_TENSOR* y, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event) {
+	try {
+		const auto profile_start = galileo::common::ProfileClock::now();
+		if (!alpha || !x || !beta || !y || !output || !x->tensor_data || !y->tensor_data || !output->tensor_data)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		if (!galileo::common::VerifyQueryPtrs(*x, *y, *output))
+			return GALILEO_RESULT::GALILEO_RESULT_TENSOR_QUEUE_MISMATCH;
+
+		if (!galileo::common::VerifyBroadcastDimensions(*x, *y, *output) || !galileo::common::IsWritable(output->dimensions))
+			return GALILEO_RESULT::GALILEO_RESULT_TENSOR_DIMENSIONS_MISMATCH;
+
+		auto queue = x->associated_queue;
+
+		const auto x_ptr_state = galileo::common::VerifyTensor(*x);
+		const auto y_ptr_state = galileo::common::VerifyTensor(*y);
+		const auto output_ptr_state = galileo::common::VerifyTensor(*output);
+		if (!x_ptr_state || !y_ptr_state || !output_ptr_state)
+			return GALILEO_RESULT_NON_USM_POINTER;
+
+		auto dependencies = galileo::common::GetEvents(wait_events, wait_events_size);
+		auto make_kernel = [alpha = *alpha, beta = *beta](GALILEO_TENSOR* tensors) { return Axpby(alpha, tensors[0], beta, tensors[1], tensors[2]); };
+		galileo::common::SetEvent(event, galileo::common::ProfileOp(queue, "Axpby", profile_start, std::array{ *x, *y, *output }, [&](const auto& op_tensors) { return galileo::common::SubmitElementwiseOp(queue, op_tensors, make_kernel, dependencies); }));
+	}
+	catch (GALILEO_RESULT res) {
+		return res;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+	return GALILEO_RESULT::GALILEO_RESULT_OK;
+}
+
+GALILEO_RESULT GALILEO_Axpby(const GALILEO_SCALAR* alpha, const GALILEO_TENSOR* x, const GALILEO_SCALAR* beta, const GALILEO_TENSOR* y, GALILEO_TENSOR* output) {
+	return GALILEO_AxpbyAsync(alpha, x, beta, y, output, nullptr, 0, nullptr);
+}
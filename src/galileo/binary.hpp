@@ -1,95 +1,398 @@
+#pragma once
+
 #include "common.hpp"
+#include "types.hpp"
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
 
 namespace galileo {
 	inline namespace detail {
-		template <auto F>
+		// the output data type follows from the promoted input types, one kernel per (lhs, rhs) pair of the enabled types
+		template <GALILEO_OP op, auto F>
 		struct BinaryElementwiseOp {
 		protected:
-			using binary_eltwise_types = std::tuple<
-				std::int8_t,
-				std::int16_t,
-				std::int32_t,
-				std::int64_t,
-				std::uint8_t,
-				std::uint16_t,
-				std::uint32_t,
-				std::uint64_t,
-				float,
-				double,
-				sycl::half,
-				common::complex<float>,
-				common::complex<double>,
-				common::complex<sycl::half>
-			>;
-
-			template <bool is_const, typename T>
-			static T GetVariantFromInput(CONSTIFY(void)* ptr, GALILEO_DATA_TYPE data_type) {
-				switch (data_type) {
-				case GALILEO_UINT8: return reinterpret_cast<CONSTIFY(std::uint8_t)*>(ptr);
-				case GALILEO_UINT16: return reinterpret_cast<CONSTIFY(std::uint16_t)*>(ptr);
-				case GALILEO_UINT32: return reinterpret_cast<CONSTIFY(std::uint32_t)*>(ptr);
-				case GALILEO_UINT64: return reinterpret_cast<CONSTIFY(std::uint64_t)*>(ptr);
-				case GALILEO_INT8: return reinterpret_cast<CONSTIFY(std::int8_t)*>(ptr);
-				case GALILEO_INT16: return reinterpret_cast<CONSTIFY(std::int16_t)*>(ptr);
-				case GALILEO_INT32: return reinterpret_cast<CONSTIFY(std::int32_t)*>(ptr);
-				case GALILEO_INT64: return reinterpret_cast<CONSTIFY(std::int64_t)*>(ptr);
-				case GALILEO_FLOAT: return reinterpret_cast<CONSTIFY(float)*>(ptr);
-				case GALILEO_DOUBLE: return reinterpret_cast<CONSTIFY(double)*>(ptr);
-				case GALILEO_HALF: return reinterpret_cast<CONSTIFY(sycl::half)*>(ptr);
-				case GALILEO_COMPLEX_FLOAT: return reinterpret_cast<CONSTIFY(common::complex<float>)*>(ptr);
-				case GALILEO_COMPLEX_DOUBLE: return reinterpret_cast<CONSTIFY(common::complex<double>)*>(ptr);
-				case GALILEO_COMPLEX_HALF: return reinterpret_cast<CONSTIFY(common::complex<sycl::half>)*>(ptr);
-				default:
+			using binary_eltwise_types = enabled_types_t<op, eltwise_types_t<TypesToUse::FpWithIntegersAndComplex>>;
+
+			template <typename Src1RawType, typename Src2RawType, typename T, typename U, typename D>
+			void ProcessVectorized(sycl::handler& h, const T* input_lhs_ptr, const U* input_rhs_ptr, D* output_ptr) {
+				constexpr auto width = common::vector_width<T, U, D>;
+				const std::size_t size = this->size;
+				const auto chunks = size / width;
+				h.parallel_for(common::GetVectorizedRange(chunks, size % width != 0), [=](sycl::nd_item<1> item) {
+					const auto chunk = item.get_global_id(0);
+					if (chunk < chunks) {
+						sycl::vec<T, width> lhs;
+						sycl::vec<U, width> rhs;
+						sycl::vec<D, width> dst;
+						lhs.load(chunk, common::GetGlobalPtr(input_lhs_ptr));
+						rhs.load(chunk, common::GetGlobalPtr(input_rhs_ptr));
+						for (int k = 0; k < width; ++k)
+							dst[k] = static_cast<D>(F(static_cast<Src1RawType>(lhs[k]), static_cast<Src2RawType>(rhs[k])));
+						dst.store(chunk, common::GetGlobalPtr(output_ptr));
+					}
+					else if (chunk == chunks) {
+						for (auto i = chunks * width; i < size; ++i)
+							output_ptr[i] = static_cast<D>(F(static_cast<Src1RawType>(input_lhs_ptr[i]), static_cast<Src2RawType>(input_rhs_ptr[i])));
+					}
+					});
+			}
+
+			template <typename T, typename U>
+			void Process(sycl::handler& h, const T* input_lhs_ptr, const U* input_rhs_ptr) {
+				if constexpr (!is_supported_pair<T, U>)
 					throw GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE;
+				else {
+					using type_helper = common::TypeHelper<T, U>;
+					using Src1RawType = typename type_helper::RawFirst;
+					using Src2RawType = typename type_helper::RawSecond;
+					using D = output_t<T, U>;
+					auto output_ptr = static_cast<D*>(output);
+
+					if constexpr (common::vector_width<T, U, D> > 1) {
+						if (is_contiguous && common::IsVectorAligned<common::vector_width<T, U, D>>(input_lhs_ptr, input_rhs_ptr, output_ptr)) {
+							ProcessVectorized<Src1RawType, Src2RawType>(h, input_lhs_ptr, input_rhs_ptr, output_ptr);
+							return;
+						}
+					}
+
+					if (is_contiguous) {
+						h.parallel_for(size, [=](auto i) {
+							output_ptr[i] = Apply<T, U>(input_lhs_ptr[i], input_rhs_ptr[i]);
+							});
+						return;
+					}
+
+					auto indexer = this->indexer;
+					h.parallel_for(size, [=](sycl::id<1> i) {
+						const auto [lhs_offset, rhs_offset, output_offset] = indexer.GetOffsets(i[0]);
+						output_ptr[output_offset] = Apply<T, U>(input_lhs_ptr[lhs_offset], input_rhs_ptr[rhs_offset]);
+						});
 				}
 			}
 
-			template <typename T, typename U, typename D>
-			void Process(sycl::handler& h, const T* input_lhs_ptr, const U* input_rhs_ptr, D* output_ptr) {
+		public:
+			static constexpr auto function = F;
+			template <typename T>
+			static constexpr bool is_supported_type = common::tuple_contains_v<T, binary_eltwise_types>;
+
+			template <typename T, typename U>
+			using output_t = std::invoke_result_t<decltype(F), typename common::TypeHelper<T, U>::First, typename common::TypeHelper<T, U>::Second>;
+
+			// a result outside of the enabled types (e.g. int8 operands promoted to int32 with int32 disabled) is rejected as well
+			template <typename T, typename U>
+			static constexpr bool is_supported_pair = is_supported_type<T> && is_supported_type<U> && is_supported_type<output_t<T, U>>;
+
+			// single element, shared with the multi-tensor launch
+			template <typename T, typename U>
+			static output_t<T, U> Apply(T lhs, U rhs) {
 				using type_helper = common::TypeHelper<T, U>;
+				return F(static_cast<typename type_helper::RawFirst>(lhs), static_cast<typename type_helper::RawSecond>(rhs));
+			}
+
+			using InputType = decltype(common::GetVariantFromTuple<true>(std::declval<variant_types_t<binary_eltwise_types>>()));
+
+			InputType input_lhs;
+			InputType input_rhs;
+			void* output;
+			unsigned int size;
+			// broadcasting is resolved by the indexer, the flat path is kept for same-shaped contiguous operands
+			bool is_contiguous;
+			common::StridedIndexer<3> indexer;
+
+			BinaryElementwiseOp(const GALILEO_TENSOR& input_lhs, const GALILEO_TENSOR& input_rhs, GALILEO_TENSOR& output) :
+				input_lhs(GetVariantFromTypes<true, InputType, binary_eltwise_types>(input_lhs.tensor_data, input_lhs.data_type)),
+				input_rhs(GetVariantFromTypes<true, InputType, binary_eltwise_types>(input_rhs.tensor_data, input_rhs.data_type)),
+				output(output.tensor_data),
+				size(common::GetTotalSize(output.dimensions)),
+				is_contiguous(common::VerifyDimensionsPtrs(input_lhs, input_rhs, output) &&
+					common::IsContiguous(input_lhs.dimensions) && common::IsContiguous(input_rhs.dimensions) && common::IsContiguous(output.dimensions)),
+				indexer(output.dimensions, { &input_lhs.dimensions, &input_rhs.dimensions, &output.dimensions }) {
+				if (GetOutputDataType() != output.data_type)
+					throw GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE;
+			}
+
+			// output data type of a pair of input data types, for callers that have to allocate the output first
+			static GALILEO_DATA_TYPE GetOutputDataType(GALILEO_DATA_TYPE lhs, GALILEO_DATA_TYPE rhs) {
+				return GetOutputDataType(GetVariantFromTypes<true, InputType, binary_eltwise_types>(nullptr, lhs), GetVariantFromTypes<true, InputType, binary_eltwise_types>(nullptr, rhs));
+			}
+
+			static GALILEO_DATA_TYPE GetOutputDataType(const InputType& lhs, const InputType& rhs) {
+				return std::visit([]<typename T, typename U>(const T*, const U*) -> GALILEO_DATA_TYPE {
+					if constexpr (is_supported_pair<T, U>)
+						return data_type_v<output_t<T, U>>;
+					else
+						throw GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE;
+				}, lhs, rhs);
+			}
+
+			GALILEO_DATA_TYPE GetOutputDataType() const {
+				return GetOutputDataType(input_lhs, input_rhs);
+			}
+
+			void operator()(sycl::handler& h) {
+				std::visit([&](const auto* input_lhs_ptr, const auto* input_rhs_ptr) { Process(h, input_lhs_ptr, input_rhs_ptr); }, input_lhs, input_rhs);
+			}
+
+			// typed entry point for prebound plans, the alternatives are resolved once when the plan is created
+			template <typename T, typename U>
+			void Launch(sycl::handler& h) {
+				Process(h, std::get<const T*>(input_lhs), std::get<const U*>(input_rhs));
+			}
+
+			// the same element function as a plain loop on the calling thread, used for small tensors of CPU queues
+			void RunOnHost() {
+				std::visit([&]<typename T, typename U>(const T* input_lhs_ptr, const U* input_rhs_ptr) {
+					if constexpr (!is_supported_pair<T, U>)
+						throw GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE;
+					else {
+						auto output_ptr = static_cast<output_t<T, U>*>(output);
+						if (is_contiguous) {
+							for (unsigned int i = 0; i < size; ++i)
+								output_ptr[i] = Apply<T, U>(input_lhs_ptr[i], input_rhs_ptr[i]);
+						}
+						else {
+							for (unsigned int i = 0; i < size; ++i) {
+								const auto [lhs_offset, rhs_offset, output_offset] = indexer.GetOffsets(i);
+								output_ptr[output_offset] = Apply<T, U>(input_lhs_ptr[lhs_offset], input_rhs_ptr[rhs_offset]);
+							}
+						}
+					}
+					}, input_lhs, input_rhs);
+			}
+		};
+
+		using scalar_eltwise_types = eltwise_types_t<TypesToUse::FpWithIntegersAndComplex>;
+		using ScalarType = decltype(common::GetVariantFromTuple<true>(std::declval<scalar_eltwise_types>()));
+
+		// the value union of GALILEO_SCALAR is laid out as the corresponding element type
+		inline ScalarType GetScalarVariant(const GALILEO_SCALAR& scalar) {
+			return GetVariantFromTypes<true, ScalarType, scalar_eltwise_types>(&scalar.value, scalar.data_type);
+		}
+
+		template <typename T>
+		T GetScalar(const GALILEO_SCALAR& scalar) {
+			return std::visit([](const auto* scalar_ptr) { return common::Convert<T>(*scalar_ptr); }, GetScalarVariant(scalar));
+		}
+
+		// tensor-scalar op, the output data type follows from the promoted input and scalar types like for the tensor-tensor ops
+		// the scalar is converted to its compute type on the host and passed into the kernel by value, one kernel per (input, scalar) pair
+		template <GALILEO_OP op, auto F, bool is_scalar_first = false>
+		struct BinaryScalarOp {
+		protected:
+			// the scalar is a host value, only the tensor types limit the kernels
+			using scalar_input_types = enabled_types_t<op, scalar_eltwise_types>;
 
-				using Src1Type = typename type_helper::First;
-				using Src2Type = typename type_helper::Second;
-				using Src1RawType = typename type_helper::RawFirst;
-				using Src2RawType = typename type_helper::RawSecond;
-				using invoke_result = std::invoke_result_t<decltype(F), Src1Type, Src2Type>;
-				//if constexpr (common::is_narrowing_conversion<invoke_result, D>)
-				if constexpr (!std::is_same_v<invoke_result, D>) // todo: switch to narrowing_conversion, bypass is used to speedup the  build process
-					throw std::runtime_error("Requested type requires narrowing conversion from the calculation result, add explicit cast or quantization");
+			template <typename T, typename S>
+			using type_helper_t = std::conditional_t<is_scalar_first, common::TypeHelper<S, T>, common::TypeHelper<T, S>>;
+
+			template <typename T, typename S>
+			void Process(sycl::handler& h, const T* input_ptr, const S* scalar_ptr) {
+				if constexpr (!is_supported_pair<T, S>)
+					throw GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE;
 				else {
-					h.parallel_for(size, [=](auto i) {
-						auto lhs = static_cast<Src1RawType>(input_lhs_ptr[i]);
-						auto rhs = static_cast<Src2RawType>(input_rhs_ptr[i]);
-						auto dst = F(lhs, rhs);
-						output_ptr[i] = static_cast<D>(dst);
+					using type_helper = type_helper_t<T, S>;
+					using InputRawType = std::conditional_t<is_scalar_first, typename type_helper::RawSecond, typename type_helper::RawFirst>;
+					using ScalarRawType = std::conditional_t<is_scalar_first, typename type_helper::RawFirst, typename type_helper::RawSecond>;
+					using D = output_t<T, S>;
+					auto output_ptr = static_cast<D*>(output);
+					const auto scalar = common::Convert<ScalarRawType>(*scalar_ptr);
+					auto apply = [](InputRawType value, ScalarRawType scalar) {
+						if constexpr (is_scalar_first)
+							return F(scalar, value);
+						else
+							return F(value, scalar);
+					};
+
+					if (is_contiguous) {
+						h.parallel_for(size, [=](auto i) {
+							output_ptr[i] = apply(static_cast<InputRawType>(input_ptr[i]), scalar);
+							});
+						return;
+					}
+
+					auto indexer = this->indexer;
+					h.parallel_for(size, [=](sycl::id<1> i) {
+						const auto [input_offset, output_offset] = indexer.GetOffsets(i[0]);
+						output_ptr[output_offset] = apply(static_cast<InputRawType>(input_ptr[input_offset]), scalar);
 						});
 				}
 			}
 
 		public:
-			using InputType = decltype(common::GetVariantFromTuple<true>(std::declval<binary_eltwise_types>()));
-			using OutputType = decltype(common::GetVariantFromTuple<false>(std::declval<binary_eltwise_types>()));
+			template <typename T, typename S>
+			using output_t = std::invoke_result_t<decltype(F), typename type_helper_t<T, S>::First, typename type_helper_t<T, S>::Second>;
 
-			InputType input_lhs;
-			InputType input_rhs;
-			OutputType output;
-			unsigned int size; // todo: consider broadcasting
+			template <typename T, typename S>
+			static constexpr bool is_supported_pair = common::tuple_contains_v<T, scalar_input_types> && common::tuple_contains_v<output_t<T, S>, scalar_input_types>;
 
-			BinaryElementwiseOp(const GALILEO_TENSOR& input_lhs, const GALILEO_TENSOR& input_rhs, GALILEO_TENSOR& output) :
-				input_lhs(GetVariantFromInput<true, InputType>(input_lhs.tensor_data, input_lhs.data_type)),
-				input_rhs(GetVariantFromInput<true, InputType>(input_rhs.tensor_data, input_rhs.data_type)),
-				output(GetVariantFromInput<false, OutputType>(output.tensor_data, output.data_type)),
-				size(common::GetTotalSize(input_lhs.dimensions)) {}
+			using InputType = decltype(common::GetVariantFromTuple<true>(std::declval<variant_types_t<scalar_input_types>>()));
+
+			InputType input;
+			ScalarType scalar;
+			void* output;
+			unsigned int size;
+			bool is_contiguous;
+			common::StridedIndexer<2> indexer;
+
+			BinaryScalarOp(const GALILEO_TENSOR& input, const GALILEO_SCALAR& scalar, GALILEO_TENSOR& output) :
+				input(GetVariantFromTypes<true, InputType, scalar_input_types>(input.tensor_data, input.data_type)),
+				scalar(GetScalarVariant(scalar)),
+				output(output.tensor_data),
+				size(common::GetTotalSize(output.dimensions)),
+				is_contiguous(common::IsContiguous(input.dimensions) && common::IsContiguous(output.dimensions)),
+				indexer(output.dimensions, { &input.dimensions, &output.dimensions }) {
+				if (GetOutputDataType() != output.data_type)
+					throw GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE;
+			}
+
+			GALILEO_DATA_TYPE GetOutputDataType() const {
+				return std::visit([]<typename T, typename S>(const T*, const S*) -> GALILEO_DATA_TYPE {
+					if constexpr (is_supported_pair<T, S>)
+						return data_type_v<output_t<T, S>>;
+					else
+						throw GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE;
+				}, input, scalar);
+			}
 
 			void operator()(sycl::handler& h) {
-				std::visit([&](const auto* input_lhs_ptr, const auto* input_rhs_ptr, auto* output_ptr) { Process(h, input_lhs_ptr, input_rhs_ptr, output_ptr); }, input_lhs, input_rhs, output);
+				std::visit([&](const auto* input_ptr, const auto* scalar_ptr) { Process(h, input_ptr, scalar_ptr); }, input, scalar);
 			}
 		};
 
+		// output = alpha * x + beta * y, the output data type is the one of x + y
+		// the sum is evaluated in its compute type with the scalars converted on the host, one kernel per (x, y) pair
+		// so the scalars have to be values of that type: 0.5 for an integer output or a complex scalar of a real one are rejected rather than truncated
+		struct AxpbyOp {
+		protected:
+			// built from a multiplication and an addition, so both ops have to be enabled
+			using axpby_types = enabled_types_t<GALILEO_OP_ADD, enabled_types_t<GALILEO_OP_MUL, scalar_eltwise_types>>;
+
+			// floating-point scalars of a floating-point compute type are only rounded, like any other operand
+			template <typename C>
+			static bool IsRepresentable(const GALILEO_SCALAR& scalar) {
+				return std::visit([]<typename S>(const S* scalar_ptr) {
+					const auto value = *scalar_ptr;
+					if constexpr (common::is_complex_v<S>)
+						return common::is_complex_v<C>;
+					else if constexpr (!std::is_integral_v<C>)
+						return true;
+					else if constexpr (std::is_integral_v<S>)
+						return common::Convert<S>(common::Convert<C>(value)) == value;
+					else {
+						// out-of-range and NaN values have no integer conversion
+						const auto real_value = common::Convert<double>(value);
+						const auto bound = std::ldexp(1.0, std::numeric_limits<C>::digits);
+						if (!(real_value >= (std::is_signed_v<C> ? -bound : 0.0) && real_value < bound))
+							return false;
+						return common::Convert<double>(common::Convert<C>(value)) == real_value;
+					}
+				}, GetScalarVariant(scalar));
+			}
+
+			template <typename T, typename U>
+			void Process(sycl::handler& h, const T* x_ptr, const U* y_ptr) {
+				if constexpr (!is_supported_pair<T, U>)
+					throw GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE;
+				else {
+					using D = output_t<T, U>;
+					using C = common::compute_t<D>;
+					auto output_ptr = static_cast<D*>(output);
+					const auto alpha = GetScalar<C>(this->alpha);
+					const auto beta = GetScalar<C>(this->beta);
+					auto apply = [=](T x, U y) {
+						return common::Convert<D>(alpha * common::Convert<C>(x) + beta * common::Convert<C>(y));
+					};
+
+					if (is_contiguous) {
+						h.parallel_for(size, [=](auto i) {
+							output_ptr[i] = apply(x_ptr[i], y_ptr[i]);
+							});
+						return;
+					}
+
+					auto indexer = this->indexer;
+					h.parallel_for(size, [=](sycl::id<1> i) {
+						const auto [x_offset, y_offset, output_offset] = indexer.GetOffsets(i[0]);
+						output_ptr[output_offset] = apply(x_ptr[x_offset], y_ptr[y_offset]);
+						});
+				}
+			}
+
+		public:
+			template <typename T, typename U>
+			using output_t = decltype(std::declval<typename common::TypeHelper<T, U>::First>() + std::declval<typename common::TypeHelper<T, U>::Second>());
+
+			template <typename T, typename U>
+			static constexpr bool is_supported_pair = common::tuple_contains_v<T, axpby_types> && common::tuple_contains_v<U, axpby_types> && common::tuple_contains_v<output_t<T, U>, axpby_types>;
+
+			using InputType = decltype(common::GetVariantFromTuple<true>(std::declval<variant_types_t<axpby_types>>()));
+
+			GALILEO_SCALAR alpha;
+			GALILEO_SCALAR beta;
+			InputType x;
+			InputType y;
+			void* output;
+			unsigned int size;
+			bool is_contiguous;
+			common::StridedIndexer<3> indexer;
+
+			AxpbyOp(const GALILEO_SCALAR& alpha, const GALILEO_TENSOR& x, const GALILEO_SCALAR& beta, const GALILEO_TENSOR& y, GALILEO_TENSOR& output) :
+				alpha(alpha),
+				beta(beta),
+				x(GetVariantFromTypes<true, InputType, axpby_types>(x.tensor_data, x.data_type)),
+				y(GetVariantFromTypes<true, InputType, axpby_types>(y.tensor_data, y.data_type)),
+				output(output.tensor_data),
+				size(common::GetTotalSize(output.dimensions)),
+				is_contiguous(common::VerifyDimensionsPtrs(x, y, output) &&
+					common::IsContiguous(x.dimensions) && common::IsContiguous(y.dimensions) && common::IsContiguous(output.dimensions)),
+				indexer(output.dimensions, { &x.dimensions, &y.dimensions, &output.dimensions }) {
+				if (GetOutputDataType() != output.data_type)
+					throw GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE;
+				const auto is_representable = std::visit([&]<typename T, typename U>(const T*, const U*) {
+					if constexpr (is_supported_pair<T, U>) {
+						using C = common::compute_t<output_t<T, U>>;
+						return IsRepresentable<C>(alpha) && IsRepresentable<C>(beta);
+					}
+					else
+						return false;
+				}, this->x, this->y);
+				if (!is_representable)
+					throw GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE;
+			}
+
+			GALILEO_DATA_TYPE GetOutputDataType() const {
+				return std::visit([]<typename T, typename U>(const T*, const U*) -> GALILEO_DATA_TYPE {
+					if constexpr (is_supported_pair<T, U>)
+						return data_type_v<output_t<T, U>>;
+					else
+						throw GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE;
+				}, x, y);
+			}
+
+			void operator()(sycl::handler& h) {
+				std::visit([&](const auto* x_ptr, const auto* y_ptr) { Process(h, x_ptr, y_ptr); }, x, y);
+			}
+		};
 	}
 }
 
-using Add = galileo::BinaryElementwiseOp < [](auto lhs, auto rhs) { return lhs + rhs; } > ;
-using Mul = galileo::BinaryElementwiseOp < [](auto lhs, auto rhs) { return lhs * rhs; } > ;
-using Div = galileo::BinaryElementwiseOp < [](auto lhs, auto rhs) { return lhs / rhs; } > ;
-using Sub = galileo::BinaryElementwiseOp < [](auto lhs, auto rhs) { return lhs - rhs; } > ;
+using Add = galileo::BinaryElementwiseOp < GALILEO_OP_ADD, [](auto lhs, auto rhs) { return lhs + rhs; } > ;
+using Mul = galileo::BinaryElementwiseOp < GALILEO_OP_MUL, [](auto lhs, auto rhs) { return lhs * rhs; } > ;
+using Div = galileo::BinaryElementwiseOp < GALILEO_OP_DIV, [](auto lhs, auto rhs) { return lhs / rhs; } > ;
+using Sub = galileo::BinaryElementwiseOp < GALILEO_OP_SUB, [](auto lhs, auto rhs) { return lhs - rhs; } > ;
+
+using AddScalar = galileo::BinaryScalarOp < GALILEO_OP_ADD, Add::function > ;
+using MulScalar = galileo::BinaryScalarOp < GALILEO_OP_MUL, Mul::function > ;
+using DivScalar = galileo::BinaryScalarOp < GALILEO_OP_DIV, Div::function > ;
+using SubScalar = galileo::BinaryScalarOp < GALILEO_OP_SUB, Sub::function > ;
+using ScalarDiv = galileo::BinaryScalarOp < GALILEO_OP_DIV, Div::function, true > ;
+using ScalarSub = galileo::BinaryScalarOp < GALILEO_OP_SUB, Sub::function, true > ;
+using Axpby = galileo::AxpbyOp;
+
+#define GALILEO_BINARY_OPS(X) \
+	X(Add, ADD) \
+	X(Div, DIV) \
+	X(Mul, MUL) \
+	X(Sub, SUB)
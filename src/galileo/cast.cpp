@@ -0,0 +1,86 @@
+#include "common.hpp"
+#include "context.hpp"
+#include "cast.hpp"
+
+GALILEO_RESULT GALILEO_CastAsync(const GALILEO_TENSOR* input, GALILEO_TENSOR* output, GALILEO_ROUNDING_MODE rounding, int saturate, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event) {
+	try {
+		const auto profile_start = galileo::common::ProfileClock::now();
+		if (!input || !output || !input->tensor_data || !output->tensor_data)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		if (!galileo::common::VerifyQueryPtrs(*input, *output))
+			return GALILEO_RESULT::GALILEO_RESULT_TENSOR_QUEUE_MISMATCH;
+
+		if (!galileo::common::VerifyDimensionsPtrs(*input, *output) || !galileo::common::IsWritable(output->dimensions))
+			return GALILEO_RESULT::GALILEO_RESULT_TENSOR_DIMENSIONS_MISMATCH;
+
+		auto queue = input->associated_queue;
+
+		const auto input_ptr_state = galileo::common::VerifyTensor(*input);
+		const auto output_ptr_state = galileo::common::VerifyTensor(*output);
+		if (!input_ptr_state || !output_ptr_state)
+			return GALILEO_RESULT_NON_USM_POINTER;
+
+		auto dependencies = galileo::common::GetEvents(wait_events, wait_events_size);
+		auto make_kernel = [rounding, saturate](GALILEO_TENSOR* tensors) { return Cast(tensors[0], tensors[1], rounding, saturate != 0); };
+		galileo::common::SetEvent(event, galileo::common::ProfileOp(queue, "Cast", profile_start, std::array{ *input, *output }, [&](const auto& op_tensors) { return galileo::common::SubmitElementwiseOp(queue, op_tensors, make_kernel, dependencies); }));
+	}
+	catch (GALILEO_RESULT res) {
+		return res;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+	return GALILEO_RESULT::GALILEO_RESULT_OK;
+}
+
+GALILEO_RESULT GALILEO_Cast(const GALILEO_TENSOR* input, GALILEO_TENSOR* output, GALILEO_ROUNDING_MODE rounding, int saturate) {
+	return GALILEO_CastAsync(input, output, rounding, saturate, nullptr, 0, nullptr);
+}
+
+#define QUANTIZE_FUNCTION_DEF(EXT_NAME, ASYNC_EXT_NAME, KERNEL_NAME) GALILEO_RESULT ASYNC_EXT_NAME(const GALILEO_TENSOR* input, const GALILEO_TENSOR* scale, const GALILEO_TENSOR* zero_point, int axis, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event) { \
+	try { \
+		const auto profile_start = galileo::common::ProfileClock::now(); \
+		if (!input || !scale || !output || !input->tensor_data || !scale->tensor_data || !output->tensor_data || (zero_point && !zero_point->tensor_data)) \
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER; \
+	 \
+		if (!galileo::common::VerifyQueryPtrs(*input, *scale, *output) || (zero_point && zero_point->associated_queue != input->associated_queue)) \
+			return GALILEO_RESULT::GALILEO_RESULT_TENSOR_QUEUE_MISMATCH; \
+	 \
+		if (!galileo::common::VerifyDimensionsPtrs(*input, *output) || !galileo::common::IsWritable(output->dimensions) || \
+			!galileo::common::IsContiguous(scale->dimensions) || (zero_point && !galileo::common::IsContiguous(zero_point->dimensions))) \
+			return GALILEO_RESULT::GALILEO_RESULT_TENSOR_DIMENSIONS_MISMATCH; \
+	 \
+		auto queue = input->associated_queue; \
+	 \
+		const auto input_ptr_state = galileo::common::VerifyTensor(*input); \
+		const auto scale_ptr_state = galileo::common::VerifyTensor(*scale); \
+		const auto zero_point_ptr_state = !zero_point || galileo::common::VerifyTensor(*zero_point); \
+		const auto output_ptr_state = galileo::common::VerifyTensor(*output); \
+		if (!input_ptr_state || !scale_ptr_state || !zero_point_ptr_state || !output_ptr_state) \
+			return GALILEO_RESULT_NON_USM_POINTER; \
+	\
+		auto dependencies = galileo::common::GetEvents(wait_events, wait_events_size); \
+		auto make_kernel = [has_zero_point = zero_point != nullptr, axis](GALILEO_TENSOR* tensors) { \
+			return KERNEL_NAME(tensors[0], tensors[1], has_zero_point ? &tensors[2] : nullptr, axis, tensors[3]); \
+		}; \
+		const auto tensors = std::array{ *input, *scale, zero_point ? *zero_point : GALILEO_TENSOR{}, *output }; \
+		galileo::common::SetEvent(event, galileo::common::ProfileOp(queue, #KERNEL_NAME, profile_start, tensors, [&](const auto& op_tensors) { return galileo::common::SubmitOp(queue, op_tensors, make_kernel, dependencies); })); \
+	} \
+	catch (GALILEO_RESULT res) { \
+		return res; \
+	} \
+	catch (...) { \
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR; \
+	} \
+	return GALILEO_RESULT::GALILEO_RESULT_OK; \
+} \
+GALILEO_RESULT EXT_NAME(const GALILEO_TENSOR* input, const GALILEO_TENSOR* scale, const GALILEO_TENSOR* zero_point, int axis, GALILEO_TENSOR* output) { \
+	return ASYNC_EXT_NAME(input, scale, zero_point, axis, output, nullptr, 0, nullptr); \
+}
+#define CREATE_EXT_NAME( s ) GALILEO_ ## s
+#define CREATE_ASYNC_EXT_NAME( s ) GALILEO_ ## s ## Async
+#define QUANTIZE_FUNCTION(NAME) QUANTIZE_FUNCTION_DEF(CREATE_EXT_NAME(NAME), CREATE_ASYNC_EXT_NAME(NAME), NAME)
+
+QUANTIZE_FUNCTION(Quantize)
+QUANTIZE_FUNCTION(Dequantize)
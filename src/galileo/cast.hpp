@@ -0,0 +1,196 @@
+#pragma once
+
+#include "common.hpp"
+#include "types.hpp"
+
+#include <limits>
+#include <utility>
+
+namespace galileo {
+	inline namespace detail {
+		// floating-point values are rounded in float, or in double when either side needs it
+		template <typename T, typename D>
+		using rounding_t = std::conditional_t<std::is_same_v<T, double> || sizeof(D) > 4, double, float>;
+
+		template <typename W>
+		W Round(W value, GALILEO_ROUNDING_MODE rounding) {
+			switch (rounding) {
+			case GALILEO_ROUNDING_NEAREST_EVEN: return sycl::rint(value);
+			case GALILEO_ROUNDING_FLOOR: return sycl::floor(value);
+			case GALILEO_ROUNDING_CEIL: return sycl::ceil(value);
+			default: return sycl::trunc(value);
+			}
+		}
+
+		// complex to real keeps the real part, saturation clamps to the range of the destination (NaN becomes zero for integers)
+		template <typename D, typename T>
+		D CastValue(T value, GALILEO_ROUNDING_MODE rounding, bool saturate) {
+			if constexpr (common::is_complex_v<D>)
+				return common::Convert<D>(value);
+			else if constexpr (common::is_complex_v<T>)
+				return CastValue<D>(value.real(), rounding, saturate);
+			else if constexpr (std::is_integral_v<D> && std::is_integral_v<T>) {
+				if (saturate && std::cmp_less(value, std::numeric_limits<D>::lowest()))
+					return std::numeric_limits<D>::lowest();
+				if (saturate && std::cmp_greater(value, std::numeric_limits<D>::max()))
+					return std::numeric_limits<D>::max();
+				return static_cast<D>(value);
+			}
+			else if constexpr (std::is_integral_v<D>) {
+				using W = rounding_t<T, D>;
+				const auto rounded = Round(static_cast<W>(value), rounding);
+				if (saturate) {
+					if (sycl::isnan(rounded))
+						return D(0);
+					// max + 1 is a power of two and stays exact where max itself is not representable
+					if (rounded >= static_cast<W>(std::numeric_limits<D>::max()) + W(1))
+						return std::numeric_limits<D>::max();
+					if (rounded <= static_cast<W>(std::numeric_limits<D>::lowest()))
+						return std::numeric_limits<D>::lowest();
+				}
+				return static_cast<D>(rounded);
+			}
+			else if constexpr (std::is_integral_v<T>)
+				return common::Convert<D>(value);
+			else {
+				using W = rounding_t<T, D>;
+				const auto wide = static_cast<W>(value);
+				if (saturate && wide > static_cast<W>(common::numeric_limits<D>::max()))
+					return common::Convert<D>(common::numeric_limits<D>::max());
+				if (saturate && wide < static_cast<W>(common::numeric_limits<D>::lowest()))
+					return common::Convert<D>(common::numeric_limits<D>::lowest());
+				return common::Convert<D>(value);
+			}
+		}
+
+		struct CastOp {
+		protected:
+			using cast_types = enabled_data_types_t<eltwise_types_t<TypesToUse::FpWithIntegersAndComplex>>;
+
+			template <typename T, typename D>
+			void Process(sycl::handler& h, const T* input_ptr, D* output_ptr) {
+				const auto rounding = this->rounding;
+				const auto saturate = this->saturate;
+				if (is_contiguous) {
+					h.parallel_for(size, [=](auto i) {
+						output_ptr[i] = CastValue<D>(input_ptr[i], rounding, saturate);
+						});
+					return;
+				}
+
+				auto indexer = this->indexer;
+				h.parallel_for(size, [=](sycl::id<1> i) {
+					const auto [input_offset, output_offset] = indexer.GetOffsets(i[0]);
+					output_ptr[output_offset] = CastValue<D>(input_ptr[input_offset], rounding, saturate);
+					});
+			}
+
+		public:
+			using InputType = decltype(common::GetVariantFromTuple<true>(std::declval<variant_types_t<cast_types>>()));
+			using OutputType = decltype(common::GetVariantFromTuple<false>(std::declval<variant_types_t<cast_types>>()));
+
+			InputType input;
+			OutputType output;
+			GALILEO_ROUNDING_MODE rounding;
+			bool saturate;
+			unsigned int size;
+			bool is_contiguous;
+			common::StridedIndexer<2> indexer;
+
+			CastOp(const GALILEO_TENSOR& input, GALILEO_TENSOR& output, GALILEO_ROUNDING_MODE rounding, bool saturate) :
+				input(GetVariantFromTypes<true, InputType, cast_types>(input.tensor_data, input.data_type)),
+				output(GetVariantFromTypes<false, OutputType, cast_types>(output.tensor_data, output.data_type)),
+				rounding(rounding),
+				saturate(saturate),
+				size(common::GetTotalSize(output.dimensions)),
+				is_contiguous(common::IsContiguous(input.dimensions) && common::IsContiguous(output.dimensions)),
+				indexer(output.dimensions, { &input.dimensions, &output.dimensions }) {}
+
+			void operator()(sycl::handler& h) {
+				std::visit([&](const auto* input_ptr, auto* output_ptr) { Process(h, input_ptr, output_ptr); }, input, output);
+			}
+		};
+
+		// affine 8-bit quantization, q = saturate(rint(x / scale) + zero_point), with one scale per tensor or per channel of the axis
+		template <bool is_quantize>
+		struct QuantizeOp {
+		protected:
+			// the 8-bit side is the format itself, only the real side follows GALILEO_TYPES
+			using real_types = enabled_data_types_t<eltwise_types_fp>;
+			using quantized_types = std::tuple<std::int8_t, std::uint8_t>;
+			using input_types = std::conditional_t<is_quantize, real_types, quantized_types>;
+			using output_types = std::conditional_t<is_quantize, quantized_types, real_types>;
+
+			template <typename T, typename D>
+			void Process(sycl::handler& h, const T* input_ptr, D* output_ptr) {
+				const auto scale_ptr = this->scale;
+				const auto zero_point_ptr = this->zero_point;
+				const std::size_t channels = this->channels;
+				const std::size_t inner_size = this->inner_size;
+				const auto is_contiguous = this->is_contiguous;
+				auto indexer = this->indexer;
+
+				h.parallel_for(size, [=](sycl::id<1> i) {
+					const auto index = i[0];
+					const auto [input_offset, output_offset] = is_contiguous ? std::array<std::size_t, 2>{ index, index } : indexer.GetOffsets(index);
+					const auto channel = channels == 1 ? 0 : index / inner_size % channels;
+					const auto scale = scale_ptr[channel];
+					const auto zero_point = zero_point_ptr ? zero_point_ptr[channel] : 0;
+					if constexpr (is_quantize) {
+						const auto value = sycl::rint(static_cast<float>(input_ptr[input_offset]) / scale) + static_cast<float>(zero_point);
+						output_ptr[output_offset] = CastValue<D>(value, GALILEO_ROUNDING_TRUNCATE, true);
+					}
+					else
+						output_ptr[output_offset] = static_cast<D>((static_cast<float>(input_ptr[input_offset]) - static_cast<float>(zero_point)) * scale);
+					});
+			}
+
+		public:
+			using InputType = decltype(common::GetVariantFromTuple<true>(std::declval<variant_types_t<input_types>>()));
+			using OutputType = decltype(common::GetVariantFromTuple<false>(std::declval<variant_types_t<output_types>>()));
+
+			InputType input;
+			OutputType output;
+			const float* scale;
+			const std::int32_t* zero_point;
+			std::size_t channels = 1;
+			std::size_t inner_size = 1;
+			unsigned int size;
+			bool is_contiguous;
+			common::StridedIndexer<2> indexer;
+
+			// scale is GALILEO_FLOAT and zero point (optional) GALILEO_INT32, both with one element or one per channel
+			QuantizeOp(const GALILEO_TENSOR& input, const GALILEO_TENSOR& scale, const GALILEO_TENSOR* zero_point, int axis, GALILEO_TENSOR& output) :
+				input(GetVariantFromTypes<true, InputType, input_types>(input.tensor_data, input.data_type)),
+				output(GetVariantFromTypes<false, OutputType, output_types>(output.tensor_data, output.data_type)),
+				scale(static_cast<const float*>(scale.tensor_data)),
+				zero_point(zero_point ? static_cast<const std::int32_t*>(zero_point->tensor_data) : nullptr),
+				size(common::GetTotalSize(output.dimensions)),
+				is_contiguous(common::IsContiguous(input.dimensions) && common::IsContiguous(output.dimensions)),
+				indexer(output.dimensions, { &input.dimensions, &output.dimensions }) {
+				if (scale.data_type != GALILEO_FLOAT || (zero_point && zero_point->data_type != GALILEO_INT32))
+					throw GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE;
+
+				const auto& dimensions = output.dimensions;
+				const auto scale_size = common::GetTotalSize(scale.dimensions);
+				if (scale_size != 1) {
+					if (axis < 0 || static_cast<unsigned int>(axis) >= dimensions.tensor_dimensions_size || dimensions.tensor_dimensions[axis] != scale_size)
+						throw GALILEO_RESULT::GALILEO_RESULT_TENSOR_DIMENSIONS_MISMATCH;
+					channels = scale_size;
+					for (auto i = static_cast<unsigned int>(axis) + 1; i < dimensions.tensor_dimensions_size; ++i)
+						inner_size *= dimensions.tensor_dimensions[i];
+				}
+				if (zero_point && common::GetTotalSize(zero_point->dimensions) != scale_size)
+					throw GALILEO_RESULT::GALILEO_RESULT_TENSOR_DIMENSIONS_MISMATCH;
+			}
+
+			void operator()(sycl::handler& h) {
+				std::visit([&](const auto* input_ptr, auto* output_ptr) { Process(h, input_ptr, output_ptr); }, input, output);
+			}
+		};
+	}
+}
+
+using Cast = galileo::CastOp;
+using Quantize = galileo::QuantizeOp<true>;
+using Dequantize = galileo::QuantizeOp<false>;
@@ -4,11 +4,17 @@
 #define SYCL_EXT_ONEAPI_COMPLEX
 #include <sycl/sycl.hpp>
 #include <sycl/ext/oneapi/experimental/sycl_complex.hpp>
+#include <sycl/ext/oneapi/bfloat16.hpp>
 
 #include <algorithm>
+#include <array>
+#include <functional>
+#include <initializer_list>
+#include <limits>
 #include <numeric>
 #include <type_traits>
 #include <variant>
+#include <vector>
 
 #include "../../external/type_map/include/type_map.hpp"
 
@@ -18,6 +24,8 @@ namespace galileo::common {
 	template <typename T>
 	using complex = sycl::ext::oneapi::experimental::complex<T>;
 
+	using bfloat16 = sycl::ext::oneapi::bfloat16;
+
 	template <bool is_const, typename ... Args>
 	constexpr std::variant<CONSTIFY(Args)*...> GetVariantFromTuple(std::tuple<Args...> t);
 
@@ -28,45 +36,94 @@ namespace galileo::common {
 		return *reinterpret_cast<sycl::queue*>(queue);
 	}
 
-	inline void* TypeErasedAllocate(sycl::queue& queue, GALILEO_DATA_TYPE data_type, unsigned int size) {
+	inline auto& GetEvent(GALILEO_EVENT event) {
+		return *reinterpret_cast<sycl::event*>(event);
+	}
+
+	inline std::vector<sycl::event> GetEvents(const GALILEO_EVENT* events, unsigned int events_size) {
+		if (events_size && !events)
+			throw GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		std::vector<sycl::event> typed_events;
+		typed_events.reserve(events_size);
+		for (unsigned int i = 0; i < events_size; ++i) {
+			if (!events[i])
+				throw GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+			typed_events.push_back(GetEvent(events[i]));
+		}
+		return typed_events;
+	}
+
+	inline void SetEvent(GALILEO_EVENT* event, const sycl::event& typed_event) {
+		if (event)
+			*event = new sycl::event(typed_event);
+	}
+
+	inline std::size_t GetDataTypeSize(GALILEO_DATA_TYPE data_type) {
 		switch (data_type) {
 		case GALILEO_UINT8:
-			return sycl::malloc_shared<std::uint8_t>(size, queue);
+			return sizeof(std::uint8_t);
 		case GALILEO_UINT16:
-			return sycl::malloc_shared<std::uint16_t>(size, queue);
+			return sizeof(std::uint16_t);
 		case GALILEO_UINT32:
-			return sycl::malloc_shared<std::uint32_t>(size, queue);
+			return sizeof(std::uint32_t);
 		case GALILEO_UINT64:
-			return sycl::malloc_shared<std::uint64_t>(size, queue);
+			return sizeof(std::uint64_t);
 		case GALILEO_INT8:
-			return sycl::malloc_shared<std::int8_t>(size, queue);
+			return sizeof(std::int8_t);
 		case GALILEO_INT16:
-			return sycl::malloc_shared<std::int16_t>(size, queue);
+			return sizeof(std::int16_t);
 		case GALILEO_INT32:
-			return sycl::malloc_shared<std::int32_t>(size, queue);
+			return sizeof(std::int32_t);
 		case GALILEO_INT64:
-			return sycl::malloc_shared<std::int64_t>(size, queue);
+			return sizeof(std::int64_t);
 		case GALILEO_FLOAT:
-			return sycl::malloc_shared<float>(size, queue);
+			return sizeof(float);
 		case GALILEO_DOUBLE:
-			return sycl::malloc_shared<double>(size, queue);
+			return sizeof(double);
 		case GALILEO_HALF:
-			return sycl::malloc_shared<sycl::half>(size, queue);
+			return sizeof(sycl::half);
 		case GALILEO_COMPLEX_FLOAT:
-			return sycl::malloc_shared<complex<float>>(size, queue);
+			return sizeof(complex<float>);
 		case GALILEO_COMPLEX_DOUBLE:
-			return sycl::malloc_shared<complex<double>>(size, queue);
+			return sizeof(complex<double>);
 		case GALILEO_COMPLEX_HALF:
-			return sycl::malloc_shared<complex<sycl::half>>(size, queue);
+			return sizeof(complex<sycl::half>);
+		case GALILEO_BFLOAT16:
+			return sizeof(bfloat16);
 		default:
 			throw GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE;
 		}
 	}
 
-	inline bool VerifyPtr(sycl::queue& queue, const void* ptr) {
-		auto device = sycl::get_pointer_type(ptr, queue.get_context());
+	inline bool IsComplexDataType(GALILEO_DATA_TYPE data_type) {
+		return data_type == GALILEO_COMPLEX_FLOAT || data_type == GALILEO_COMPLEX_DOUBLE || data_type == GALILEO_COMPLEX_HALF;
+	}
+
+	inline sycl::usm::alloc GetUsmKind(GALILEO_ALLOCATION_KIND allocation_kind) {
+		switch (allocation_kind) {
+		case GALILEO_ALLOCATION_SHARED:
+			return sycl::usm::alloc::shared;
+		case GALILEO_ALLOCATION_DEVICE:
+			return sycl::usm::alloc::device;
+		case GALILEO_ALLOCATION_HOST:
+			return sycl::usm::alloc::host;
+		default:
+			throw GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+		}
+	}
 
-		return device == sycl::usm::alloc::shared;
+	inline GALILEO_ALLOCATION_KIND GetAllocationKind(sycl::usm::alloc usm_kind) {
+		switch (usm_kind) {
+		case sycl::usm::alloc::shared:
+			return GALILEO_ALLOCATION_SHARED;
+		case sycl::usm::alloc::device:
+			return GALILEO_ALLOCATION_DEVICE;
+		case sycl::usm::alloc::host:
+			return GALILEO_ALLOCATION_HOST;
+		default:
+			throw GALILEO_RESULT::GALILEO_RESULT_NON_USM_POINTER;
+		}
 	}
 
 	template <typename ... Args>
@@ -94,9 +151,132 @@ namespace galileo::common {
 		return is_same;
 	}
 
+	// numpy-style: operand dimensions are right-aligned and size one dimensions stretch to the output shape
+	inline bool VerifyBroadcastDimensions(std::initializer_list<const GALILEO_TENSOR*> inputs, const GALILEO_TENSOR& output) {
+		const auto& output_dimensions = output.dimensions;
+		for (const auto* input : inputs)
+			if (input->dimensions.tensor_dimensions_size > output_dimensions.tensor_dimensions_size)
+				return false;
+
+		auto get_aligned_dimension = [&](const GALILEO_TENSOR_DIMENSIONS& dimensions, unsigned int output_dimension) {
+			const auto offset = output_dimensions.tensor_dimensions_size - dimensions.tensor_dimensions_size;
+			return output_dimension < offset ? 1u : dimensions.tensor_dimensions[output_dimension - offset];
+		};
+		for (unsigned int i = 0; i < output_dimensions.tensor_dimensions_size; ++i) {
+			unsigned int broadcast_dimension = 1;
+			for (const auto* input : inputs) {
+				const auto input_dimension = get_aligned_dimension(input->dimensions, i);
+				if (input_dimension == 1)
+					continue;
+				if (broadcast_dimension != 1 && broadcast_dimension != input_dimension)
+					return false;
+				broadcast_dimension = input_dimension;
+			}
+			if (output_dimensions.tensor_dimensions[i] != broadcast_dimension)
+				return false;
+		}
+		return true;
+	}
+
+	inline bool VerifyBroadcastDimensions(const GALILEO_TENSOR& lhs, const GALILEO_TENSOR& rhs, const GALILEO_TENSOR& output) {
+		return VerifyBroadcastDimensions({ &lhs, &rhs }, output);
+	}
+
 	inline unsigned int GetTotalSize(const GALILEO_TENSOR_DIMENSIONS& dimensions) {
 		return std::accumulate(dimensions.tensor_dimensions,
-			dimensions.tensor_dimensions + dimensions.tensor_dimensions_size, 0);
+			dimensions.tensor_dimensions + dimensions.tensor_dimensions_size, 1u, std::multiplies<unsigned int>());
+	}
+
+	inline bool IsContiguous(const GALILEO_TENSOR_DIMENSIONS& dimensions) {
+		std::size_t expected_stride = 1;
+		for (auto i = dimensions.tensor_dimensions_size; i-- > 0;) {
+			if (dimensions.tensor_dimensions[i] != 1 && dimensions.tensor_strides[i] != expected_stride)
+				return false;
+			expected_stride *= dimensions.tensor_dimensions[i];
+		}
+		return true;
+	}
+
+	// a zero stride over a non-trivial dimension makes several elements share the memory, fine for reading only
+	inline bool IsWritable(const GALILEO_TENSOR_DIMENSIONS& dimensions) {
+		for (unsigned int i = 0; i < dimensions.tensor_dimensions_size; ++i)
+			if (dimensions.tensor_dimensions[i] > 1 && dimensions.tensor_strides[i] == 0)
+				return false;
+		return true;
+	}
+
+	// number of elements between the first and the last addressable element (inclusive)
+	inline std::size_t GetSpanSize(const GALILEO_TENSOR_DIMENSIONS& dimensions) {
+		std::size_t span = 1;
+		for (unsigned int i = 0; i < dimensions.tensor_dimensions_size; ++i) {
+			if (dimensions.tensor_dimensions[i] == 0)
+				return 0;
+			span += static_cast<std::size_t>(dimensions.tensor_dimensions[i] - 1) * dimensions.tensor_strides[i];
+		}
+		return span;
+	}
+
+	inline std::size_t GetTensorBytes(const GALILEO_TENSOR& tensor) {
+		return GetSpanSize(tensor.dimensions) * GetDataTypeSize(tensor.data_type);
+	}
+
+	// maps the linear index over the output shape to the element offsets of every operand
+	template <std::size_t operands_size>
+	struct StridedIndexer {
+		unsigned int dimensions_size = 0;
+		unsigned int dimensions[GALILEO_MAX_TENSOR_DIMENSIONS] = {};
+		std::size_t strides[operands_size][GALILEO_MAX_TENSOR_DIMENSIONS] = {};
+
+		StridedIndexer() = default;
+		StridedIndexer(const GALILEO_TENSOR_DIMENSIONS& shape, const std::array<const GALILEO_TENSOR_DIMENSIONS*, operands_size>& operands) :
+			dimensions_size(shape.tensor_dimensions_size) {
+			std::copy(shape.tensor_dimensions, shape.tensor_dimensions + dimensions_size, dimensions);
+			for (std::size_t j = 0; j < operands_size; ++j) {
+				const auto& operand = *operands[j];
+				const auto offset = dimensions_size - operand.tensor_dimensions_size;
+				for (unsigned int i = 0; i < operand.tensor_dimensions_size; ++i)
+					strides[j][offset + i] = operand.tensor_dimensions[i] == 1 ? 0 : operand.tensor_strides[i];
+			}
+		}
+
+		std::array<std::size_t, operands_size> GetOffsets(std::size_t index) const {
+			std::array<std::size_t, operands_size> offsets{};
+			for (auto i = dimensions_size; i-- > 0;) {
+				const auto coordinate = index % dimensions[i];
+				index /= dimensions[i];
+				for (std::size_t j = 0; j < operands_size; ++j)
+					offsets[j] += coordinate * strides[j][i];
+			}
+			return offsets;
+		}
+	};
+
+	// 16 bytes per operand chunk, matches the SSE lanes and a half of the AVX2/AVX-512 ones
+	constexpr std::size_t vector_bytes = 16;
+	constexpr std::size_t vector_work_group_size = 64;
+
+	template <typename T>
+	constexpr bool is_vectorizable_v = std::is_arithmetic_v<std::remove_const_t<T>> || std::is_same_v<std::remove_const_t<T>, sycl::half>;
+
+	// width is chosen by the widest operand so that every operand chunk is a valid sycl::vec
+	template <typename ... Args>
+	constexpr int vector_width = (is_vectorizable_v<Args> && ...) ? static_cast<int>(vector_bytes / std::max({ sizeof(Args)... })) : 1;
+
+	template <int width, typename ... Args>
+	bool IsVectorAligned(const Args* ...ptrs) {
+		return ((reinterpret_cast<std::uintptr_t>(ptrs) % (sizeof(Args) * width) == 0) && ...);
+	}
+
+	// one work-item per chunk plus one for the remainder
+	inline sycl::nd_range<1> GetVectorizedRange(std::size_t chunks, bool has_tail) {
+		const auto items = chunks + (has_tail ? 1 : 0);
+		const auto global_size = (items + vector_work_group_size - 1) / vector_work_group_size * vector_work_group_size;
+		return sycl::nd_range<1>(std::max(global_size, vector_work_group_size), vector_work_group_size);
+	}
+
+	template <typename T>
+	auto GetGlobalPtr(T* ptr) {
+		return sycl::address_space_cast<sycl::access::address_space::global_space, sycl::access::decorated::no>(ptr);
 	}
 
 	template <typename From, typename To>
@@ -112,18 +292,76 @@ namespace galileo::common {
 	template <typename T> struct underlying { using type = T; };
 	template <typename T> struct underlying<complex<T>> { using type = T; };
 	template <typename T> using underlying_t = typename underlying<T>::type;
+
+	// bfloat16 is a storage type, the arithmetic and the math functions are evaluated in float
+	template <typename T> struct compute { using type = T; };
+	template <> struct compute<bfloat16> { using type = float; };
+	template <> struct compute<const bfloat16> { using type = float; };
+	template <typename T> using compute_t = typename compute<T>::type;
+
+	template <typename T> struct numeric_limits : std::numeric_limits<T> {};
+	template <> struct numeric_limits<bfloat16> {
+		static constexpr bool is_integer = false;
+		static constexpr bool is_signed = true;
+		static constexpr int digits = 8;
+		static constexpr int max_exponent = 128;
+		static constexpr float max() { return 0x1.fep127f; }
+		static constexpr float lowest() { return -0x1.fep127f; }
+	};
+
+	// every value of From is kept: wider integers, floating-point types with enough significand digits and range, complex numbers of those
+	template <typename From, typename To>
+	constexpr bool IsLosslessPromotion() {
+		if constexpr (std::is_same_v<From, To>)
+			return true;
+		else if constexpr (is_complex_v<To>)
+			return IsLosslessPromotion<underlying_t<From>, underlying_t<To>>();
+		else if constexpr (is_complex_v<From>)
+			return false;
+		else {
+			using from_limits = numeric_limits<From>;
+			using to_limits = numeric_limits<To>;
+			if constexpr (from_limits::is_integer && to_limits::is_integer)
+				return from_limits::digits <= to_limits::digits && (to_limits::is_signed || !from_limits::is_signed);
+			else if constexpr (from_limits::is_integer)
+				return from_limits::digits <= to_limits::digits;
+			else if constexpr (to_limits::is_integer)
+				return false;
+			else
+				return from_limits::digits <= to_limits::digits && from_limits::max_exponent <= to_limits::max_exponent;
+		}
+	}
+
+	template <typename T, typename Tuple> struct tuple_contains;
+	template <typename T, typename ... Args> struct tuple_contains<T, std::tuple<Args...>> : std::disjunction<std::is_same<T, Args>...> {};
+	template <typename T, typename Tuple> constexpr bool tuple_contains_v = tuple_contains<T, Tuple>::value;
+
+	template <typename To, typename From>
+	To Convert(From value) {
+		if constexpr (is_complex_v<To> && is_complex_v<From>)
+			return To(static_cast<underlying_t<To>>(value.real()), static_cast<underlying_t<To>>(value.imag()));
+		else if constexpr (is_complex_v<To>)
+			return To(Convert<underlying_t<To>>(value));
+		else if constexpr (is_complex_v<From>)
+			return Convert<To>(value.real());
+		else if constexpr (std::is_same_v<To, bfloat16> || std::is_same_v<From, bfloat16>)
+			return static_cast<To>(static_cast<float>(value));
+		else
+			return static_cast<To>(value);
+	}
 	
+	// bfloat16 operands keep their type only against each other, mixed with anything else they are promoted to float
 	template <typename T1, typename T2, bool complex = false>
 	struct TypeHelperImpl {
-		using First = T1;
-		using Second = T2;
+		using First = std::conditional_t<std::is_same_v<T1, T2>, T1, compute_t<T1>>;
+		using Second = std::conditional_t<std::is_same_v<T1, T2>, T2, compute_t<T2>>;
 		using RawFirst = First;
 		using RawSecond = Second;
 	};
 	
 	template <typename T1, typename T2>
 	struct TypeHelperImpl<T1, T2, true> {
-		using helper_underlying = TypeHelperImpl<underlying_t<T1>, underlying_t<T2>>;
+		using helper_underlying = TypeHelperImpl<compute_t<underlying_t<T1>>, compute_t<underlying_t<T2>>>;
 
 		using common_type = decltype(std::declval<typename helper_underlying::First>() * std::declval<typename helper_underlying::Second>());
 		using First = complex<common_type>;
@@ -0,0 +1,285 @@
+#pragma once
+
+#include "common.hpp"
+#include "pool.hpp"
+#include "profiler.hpp"
+#include "registry.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace galileo::common {
+	// op recorded while its queue is captured, rebuilt from the tensor copies whenever it is replayed
+	struct RecordedOp {
+		std::vector<GALILEO_TENSOR> tensors;
+		std::function<sycl::event(GALILEO_QUEUE, GALILEO_TENSOR*, const std::vector<sycl::event>&)> submit;
+	};
+
+	// below a few thousand elements the submission costs more than the arithmetic
+	constexpr unsigned int default_host_threshold = 1024;
+
+	// per-queue state, kept aside so the opaque queue buffer still holds a plain sycl::queue
+	struct QueueContext {
+		SubmissionTracker tracker;
+		MemoryPool pool;
+		PointerRegistry registry;
+		HostMirrorRegistry mirrors;
+		// set between GALILEO_BeginCapture and GALILEO_EndCapture
+		std::unique_ptr<std::vector<RecordedOp>> capture;
+		// set while a graph records the captured ops, their scratch blocks are handed over to it
+		std::vector<void*>* recording_scratch = nullptr;
+		// accumulated over the GALILEO_Warmup calls
+		GALILEO_WARMUP_STATISTICS warmup{};
+		// sub-queues of a sharded queue, on the NUMA sub-devices of the device or on several devices sharing the context
+		std::vector<sycl::queue> shards;
+		bool is_multi_device = false;
+		Profiler profiler;
+		// small elementwise ops of CPU queues run on the calling thread, see IsHostFastPath
+		const bool is_cpu;
+		std::atomic<unsigned int> host_threshold;
+
+		explicit QueueContext(sycl::queue& queue) : pool(queue, tracker), profiler(queue), is_cpu(queue.get_device().is_cpu()), host_threshold(default_host_threshold) {}
+	};
+
+	class QueueContextRegistry {
+		std::shared_mutex mutex;
+		std::unordered_map<GALILEO_QUEUE, std::unique_ptr<QueueContext>> contexts;
+
+	public:
+		void Create(GALILEO_QUEUE queue) {
+			auto context = std::make_unique<QueueContext>(GetQueue(queue));
+			std::unique_lock lock(mutex);
+			contexts[queue] = std::move(context);
+		}
+
+		void Release(GALILEO_QUEUE queue) {
+			std::unique_lock lock(mutex);
+			contexts.erase(queue);
+		}
+
+		QueueContext& Get(GALILEO_QUEUE queue) {
+			std::shared_lock lock(mutex);
+			auto it = contexts.find(queue);
+			if (it == contexts.end())
+				throw GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+			return *it->second;
+		}
+	};
+
+	inline QueueContextRegistry& GetQueueContextRegistry() {
+		static QueueContextRegistry registry;
+		return registry;
+	}
+
+	inline QueueContext& GetQueueContext(GALILEO_QUEUE queue) {
+		return GetQueueContextRegistry().Get(queue);
+	}
+
+	inline std::optional<GALILEO_ALLOCATION_KIND> GetPointerKind(GALILEO_QUEUE queue, const void* ptr) {
+		if (auto allocation_kind = GetQueueContext(queue).registry.Find(ptr))
+			return allocation_kind;
+
+		// unknown to the registry, fall back to the runtime query
+		const auto usm_kind = sycl::get_pointer_type(ptr, GetQueue(queue).get_context());
+		if (usm_kind == sycl::usm::alloc::unknown)
+			return std::nullopt;
+		return GetAllocationKind(usm_kind);
+	}
+
+	inline bool VerifyPtr(GALILEO_QUEUE queue, const void* ptr) {
+		return GetPointerKind(queue, ptr).has_value();
+	}
+
+	// tensors created by GALILEO_Create1dTensor are trusted for as long as their data pointer is left untouched
+	inline bool VerifyTensor(const GALILEO_TENSOR& tensor) {
+		if (tensor.validated_data && tensor.validated_data == tensor.tensor_data)
+			return true;
+		return VerifyPtr(tensor.associated_queue, tensor.tensor_data);
+	}
+
+	// command groups submitted outside of SubmitOp (copies, fused expressions, plans) are captured as they are
+	template <typename Kernel>
+	sycl::event Submit(GALILEO_QUEUE queue, Kernel& kernel, const std::vector<sycl::event>& dependencies) {
+		auto& context = GetQueueContext(queue);
+		if (context.capture) {
+			context.capture->push_back({ {}, [kernel](GALILEO_QUEUE queue, GALILEO_TENSOR*, const std::vector<sycl::event>& dependencies) mutable {
+				return Submit(queue, kernel, dependencies);
+				} });
+			return sycl::event();
+		}
+
+		auto event = GetQueue(queue).submit([&](sycl::handler& h) {
+			h.depends_on(dependencies);
+			kernel(h);
+			});
+		// recorded graph nodes are not running commands
+		if (!context.recording_scratch) {
+			context.tracker.Track(event);
+			ProfileScope::Collect(event);
+		}
+		return event;
+	}
+
+	// builds the op from its tensors and submits it, or records it while the queue is captured
+	// the op is built in both cases, so that a capture fails on the same errors as a direct call
+	// tensors is a std::array, or a std::vector for the ops over a variable number of tensors
+	template <typename Tensors, typename MakeKernel>
+	sycl::event SubmitOp(GALILEO_QUEUE queue, Tensors tensors, MakeKernel make_kernel, const std::vector<sycl::event>& dependencies) {
+		auto submit = [make_kernel](GALILEO_QUEUE queue, GALILEO_TENSOR* tensors, const std::vector<sycl::event>& dependencies) {
+			auto kernel = make_kernel(tensors);
+			if constexpr (requires { kernel.Submit(queue, dependencies); })
+				return kernel.Submit(queue, dependencies);
+			else
+				return Submit(queue, kernel, dependencies);
+		};
+
+		auto& context = GetQueueContext(queue);
+		if (context.capture) {
+			make_kernel(tensors.data());
+			context.capture->push_back({ std::vector<GALILEO_TENSOR>(tensors.begin(), tensors.end()), submit });
+			return sycl::event();
+		}
+		return submit(queue, tensors.data(), dependencies);
+	}
+
+	// ops over fewer elements are not worth the extra submissions
+	constexpr std::size_t min_shard_size = 1 << 20;
+
+	// number of parts an op over size elements is split into, ops are never split while the queue is captured
+	inline std::size_t GetShardCount(GALILEO_QUEUE queue, std::size_t size) {
+		auto& context = GetQueueContext(queue);
+		if (context.shards.size() < 2 || size < min_shard_size || context.capture || context.recording_scratch)
+			return 1;
+		return context.shards.size();
+	}
+
+	// first element of the part of the shard, the last shard ends at size
+	inline std::size_t GetShardBegin(std::size_t size, std::size_t shard, std::size_t shards_size) {
+		return size * shard / shards_size;
+	}
+
+	template <typename Kernel>
+	sycl::event SubmitShard(GALILEO_QUEUE queue, std::size_t shard, Kernel& kernel, const std::vector<sycl::event>& dependencies) {
+		auto& context = GetQueueContext(queue);
+		auto event = context.shards[shard].submit([&](sycl::handler& h) {
+			h.depends_on(dependencies);
+			kernel(h);
+			});
+		context.tracker.Track(event);
+		ProfileScope::Collect(event);
+		return event;
+	}
+
+	// single event of the main queue for several commands, tracked like the commands themselves
+	// captured ops are replayed one after another, so a captured barrier has nothing to join and isn't recorded
+	inline sycl::event SubmitBarrier(GALILEO_QUEUE queue, const std::vector<sycl::event>& events) {
+		auto& context = GetQueueContext(queue);
+		if (context.capture)
+			return sycl::event();
+
+		auto event = GetQueue(queue).ext_oneapi_submit_barrier(events);
+		context.tracker.Track(event);
+		ProfileScope::Collect(event);
+		return event;
+	}
+
+	// the caller gets a single event of the main queue
+	inline sycl::event JoinShards(GALILEO_QUEUE queue, const std::vector<sycl::event>& events) {
+		return SubmitBarrier(queue, events);
+	}
+
+	// an op runs inline when it is small, its queue runs on the CPU, its memory is reachable from the host and nothing it may depend on is pending
+	// pending work keeps the submission, which orders the op after it without blocking the caller
+	template <std::size_t tensors_size>
+	bool IsHostFastPath(GALILEO_QUEUE queue, const std::array<GALILEO_TENSOR, tensors_size>& tensors, const std::vector<sycl::event>& dependencies) {
+		auto& context = GetQueueContext(queue);
+		if (!context.is_cpu || context.capture || context.recording_scratch || GetTotalSize(tensors.back().dimensions) > context.host_threshold)
+			return false;
+		if (std::any_of(tensors.begin(), tensors.end(), [](const GALILEO_TENSOR& tensor) { return tensor.allocation_kind == GALILEO_ALLOCATION_DEVICE; }))
+			return false;
+		auto is_complete = [](const sycl::event& event) {
+			return event.get_info<sycl::info::event::command_execution_status>() == sycl::info::event_command_status::complete;
+		};
+		return std::all_of(dependencies.begin(), dependencies.end(), is_complete) && context.tracker.IsComplete(context.tracker.GetEpoch());
+	}
+
+	// small ops of kernels with a host loop may skip the queue, see IsHostFastPath
+	// same-shaped contiguous operands are split into one flat part per shard, the others are submitted as a whole
+	template <std::size_t tensors_size, typename MakeKernel>
+	sycl::event SubmitElementwiseOp(GALILEO_QUEUE queue, std::array<GALILEO_TENSOR, tensors_size> tensors, MakeKernel make_kernel, const std::vector<sycl::event>& dependencies) {
+		using Kernel = decltype(make_kernel(tensors.data()));
+		if constexpr (requires (Kernel& kernel) { kernel.RunOnHost(); }) {
+			if (IsHostFastPath(queue, tensors, dependencies)) {
+				auto kernel = make_kernel(tensors.data());
+				kernel.RunOnHost();
+				return sycl::event();
+			}
+		}
+
+		const auto& output = tensors.back();
+		const auto size = GetTotalSize(output.dimensions);
+		const auto shards_size = GetShardCount(queue, size);
+		const auto is_multi_device = GetQueueContext(queue).is_multi_device;
+		auto is_splittable = [&](const GALILEO_TENSOR& tensor) {
+			// device allocations are only reachable from the device they were made for
+			return VerifyDimensionsPtrs(tensor, output) && IsContiguous(tensor.dimensions) && !(is_multi_device && tensor.allocation_kind == GALILEO_ALLOCATION_DEVICE);
+		};
+		if (shards_size == 1 || !std::all_of(tensors.begin(), tensors.end(), is_splittable))
+			return SubmitOp(queue, tensors, make_kernel, dependencies);
+
+		std::vector<sycl::event> events;
+		for (std::size_t shard = 0; shard < shards_size; ++shard) {
+			const auto begin = GetShardBegin(size, shard, shards_size);
+			const auto end = GetShardBegin(size, shard + 1, shards_size);
+			auto part = tensors;
+			for (auto& tensor : part) {
+				tensor.tensor_data = static_cast<std::byte*>(tensor.tensor_data) + begin * GetDataTypeSize(tensor.data_type);
+				tensor.validated_data = tensor.tensor_data;
+				tensor.dimensions.tensor_dimensions[0] = static_cast<unsigned int>(end - begin);
+				tensor.dimensions.tensor_strides[0] = 1;
+				tensor.dimensions.tensor_dimensions_size = 1;
+			}
+			auto kernel = make_kernel(part.data());
+			events.push_back(SubmitShard(queue, shard, kernel, dependencies));
+		}
+		return JoinShards(queue, events);
+	}
+
+	// records the host time of the op call from start on, the bytes of its tensors and the events of every command it submits while the queue is profiled
+	// tensors is a std::array or a std::vector, the statistics are kept per the first tensor's data type
+	// captured ops don't run until the graph is launched and aren't recorded
+	template <typename Tensors, typename SubmitTensors>
+	sycl::event ProfileOp(GALILEO_QUEUE queue, const char* name, ProfileClock::time_point start, const Tensors& tensors, SubmitTensors submit) {
+		auto& context = GetQueueContext(queue);
+		if (!context.profiler.IsEnabled() || context.capture)
+			return submit(tensors);
+
+		const auto validated = ProfileClock::now();
+		ProfileScope scope;
+		auto event = submit(tensors);
+		const auto submitted = ProfileClock::now();
+		unsigned long long bytes = 0;
+		for (const auto& tensor : tensors)
+			if (tensor.tensor_data)
+				bytes += static_cast<unsigned long long>(GetTotalSize(tensor.dimensions)) * GetDataTypeSize(tensor.data_type);
+		const auto data_type = std::empty(tensors) ? GALILEO_DATA_TYPE{} : std::begin(tensors)->data_type;
+		context.profiler.Record({ name, data_type, start, validated, submitted, bytes, scope.GetEvents() });
+		return event;
+	}
+
+	// scratch blocks of ops recorded into a command graph live as long as the graph
+	inline void ReleaseScratch(GALILEO_QUEUE queue, void* ptr) {
+		auto& context = GetQueueContext(queue);
+		if (context.recording_scratch)
+			context.recording_scratch->push_back(ptr);
+		else
+			context.pool.Deallocate(ptr);
+	}
+}
@@ -0,0 +1,122 @@
+#include "common.hpp"
+#include "fusion.hpp"
+
+GALILEO_RESULT GALILEO_CreateExpression(GALILEO_QUEUE queue, GALILEO_EXPRESSION* expression) {
+	try {
+		if (!queue || !expression)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		*expression = new galileo::Expression(queue);
+		return GALILEO_RESULT::GALILEO_RESULT_OK;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+}
+
+GALILEO_RESULT GALILEO_ReleaseExpression(GALILEO_EXPRESSION expression) {
+	if (!expression)
+		return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+	delete &galileo::GetExpression(expression);
+	return GALILEO_RESULT::GALILEO_RESULT_OK;
+}
+
+GALILEO_RESULT GALILEO_ExpressionInput(GALILEO_EXPRESSION expression, const GALILEO_TENSOR* input, GALILEO_EXPRESSION_NODE* node) {
+	try {
+		if (!expression || !input || !node || !input->tensor_data)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		auto& typed_expression = galileo::GetExpression(expression);
+		if (input->associated_queue != typed_expression.GetQueue())
+			return GALILEO_RESULT::GALILEO_RESULT_TENSOR_QUEUE_MISMATCH;
+		if (!galileo::common::VerifyTensor(*input))
+			return GALILEO_RESULT::GALILEO_RESULT_NON_USM_POINTER;
+
+		*node = typed_expression.AddInput(*input);
+		return GALILEO_RESULT::GALILEO_RESULT_OK;
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+}
+
+GALILEO_RESULT GALILEO_ExpressionUnary(GALILEO_EXPRESSION expression, GALILEO_OP op, GALILEO_EXPRESSION_NODE input, GALILEO_EXPRESSION_NODE* node) {
+	try {
+		if (!expression || !node || !galileo::IsUnaryOp(op))
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		*node = galileo::GetExpression(expression).AddOp(op, input, input);
+		return GALILEO_RESULT::GALILEO_RESULT_OK;
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+}
+
+GALILEO_RESULT GALILEO_ExpressionBinary(GALILEO_EXPRESSION expression, GALILEO_OP op, GALILEO_EXPRESSION_NODE input_lhs, GALILEO_EXPRESSION_NODE input_rhs, GALILEO_EXPRESSION_NODE* node) {
+	try {
+		if (!expression || !node || !galileo::IsBinaryOp(op))
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		*node = galileo::GetExpression(expression).AddOp(op, input_lhs, input_rhs);
+		return GALILEO_RESULT::GALILEO_RESULT_OK;
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+}
+
+GALILEO_RESULT GALILEO_ExpressionOutput(GALILEO_EXPRESSION expression, GALILEO_EXPRESSION_NODE node, GALILEO_TENSOR* output) {
+	try {
+		if (!expression || !output || !output->tensor_data)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		auto& typed_expression = galileo::GetExpression(expression);
+		if (output->associated_queue != typed_expression.GetQueue())
+			return GALILEO_RESULT::GALILEO_RESULT_TENSOR_QUEUE_MISMATCH;
+		if (!galileo::common::VerifyTensor(*output))
+			return GALILEO_RESULT::GALILEO_RESULT_NON_USM_POINTER;
+
+		typed_expression.AddOutput(node, *output);
+		return GALILEO_RESULT::GALILEO_RESULT_OK;
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+}
+
+GALILEO_RESULT GALILEO_ExpressionEvaluateAsync(GALILEO_EXPRESSION expression, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event) {
+	try {
+		const auto profile_start = galileo::common::ProfileClock::now();
+		if (!expression)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		auto& typed_expression = galileo::GetExpression(expression);
+		auto dependencies = galileo::common::GetEvents(wait_events, wait_events_size);
+		galileo::common::SetEvent(event, galileo::common::ProfileOp(typed_expression.GetQueue(), "Expression", profile_start, typed_expression.GetTensors(), [&](const auto&) { return typed_expression.Evaluate(dependencies); }));
+		return GALILEO_RESULT::GALILEO_RESULT_OK;
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+}
+
+GALILEO_RESULT GALILEO_ExpressionEvaluate(GALILEO_EXPRESSION expression) {
+	return GALILEO_ExpressionEvaluateAsync(expression, nullptr, 0, nullptr);
+}
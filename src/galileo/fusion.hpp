@@ -0,0 +1,656 @@
+#pragma once
+
+#include "common.hpp"
+#include "context.hpp"
+#include "cast.hpp"
+#include "unary.hpp"
+#include "binary.hpp"
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace galileo {
+	inline namespace detail {
+		constexpr unsigned int max_fused_inputs = 8;
+		constexpr unsigned int max_fused_outputs = 4;
+		constexpr unsigned int max_fused_instructions = 32;
+		constexpr unsigned int max_fused_registers = 16;
+
+		constexpr bool IsUnaryOp(GALILEO_OP op) {
+			return op >= GALILEO_OP_ABS && op <= GALILEO_OP_TANH;
+		}
+
+		constexpr bool IsBinaryOp(GALILEO_OP op) {
+			return op >= GALILEO_OP_ADD && op <= GALILEO_OP_SUB;
+		}
+
+		// element of a small array picked by comparisons against constant indices
+		// a dynamic subscript would move the whole array out of the registers into private memory
+		template <typename T, std::size_t size>
+		T Select(const std::array<T, size>& values, unsigned int index) {
+			return [&]<std::size_t ... indices>(std::index_sequence<indices...>) {
+				T value{};
+				static_cast<void>(((index == indices && (value = values[indices], true)) || ...));
+				return value;
+			}(std::make_index_sequence<size>());
+		}
+
+		template <typename T, std::size_t size>
+		void Assign(std::array<T, size>& values, unsigned int index, const T& value) {
+			[&]<std::size_t ... indices>(std::index_sequence<indices...>) {
+				static_cast<void>(((index == indices && (values[indices] = value, true)) || ...));
+			}(std::make_index_sequence<size>());
+		}
+
+		using fused_types = enabled_data_types_t<eltwise_types_t<TypesToUse::FpWithIntegersAndComplex>>;
+		using FusedType = decltype(common::GetVariantFromTuple<false>(std::declval<variant_types_t<fused_types>>()));
+
+		inline FusedType GetFusedType(GALILEO_DATA_TYPE data_type) {
+			return GetVariantFromTypes<false, FusedType, fused_types>(nullptr, data_type);
+		}
+
+		// a binary node runs in its own type, so the op has to map a pair of that type onto itself
+		template <typename Op, typename T>
+		constexpr bool is_fusable_binary = [] {
+			if constexpr (Op::template is_supported_pair<T, T>)
+				return std::is_same_v<typename Op::template output_t<T, T>, T>;
+			else
+				return false;
+		}();
+
+		#define FUSED_UNARY_TYPE_CASE(NAME, OP) case GALILEO_OP_ ## OP: \
+			return std::visit([]<typename T>(T*) -> GALILEO_DATA_TYPE { \
+				if constexpr (NAME::is_supported_type<T>) \
+					return data_type_v<T>; \
+				else \
+					throw GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE; \
+				}, GetFusedType(lhs));
+		#define FUSED_BINARY_TYPE_CASE(NAME, OP) case GALILEO_OP_ ## OP: \
+			return std::visit([]<typename T, typename U>(T*, U*) -> GALILEO_DATA_TYPE { \
+				if constexpr (NAME::is_supported_pair<T, U>) { \
+					if constexpr (is_fusable_binary<NAME, NAME::output_t<T, U>>) \
+						return data_type_v<NAME::output_t<T, U>>; \
+				} \
+				throw GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE; \
+				}, GetFusedType(lhs), GetFusedType(rhs));
+
+		// type of a node under the rules of the standalone op: unary ops keep the type, binary ops promote their operands
+		inline GALILEO_DATA_TYPE GetNodeDataType(GALILEO_OP op, GALILEO_DATA_TYPE lhs, GALILEO_DATA_TYPE rhs) {
+			switch (op) {
+			GALILEO_UNARY_OPS(FUSED_UNARY_TYPE_CASE)
+			GALILEO_BINARY_OPS(FUSED_BINARY_TYPE_CASE)
+			default:
+				throw GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+			}
+		}
+
+		#undef FUSED_UNARY_TYPE_CASE
+		#undef FUSED_BINARY_TYPE_CASE
+
+		// operands below fused_input_operand name a register, the others an input of the kernel
+		constexpr std::uint8_t fused_input_operand = max_fused_registers;
+
+		struct FusedInstruction {
+			GALILEO_OP op;
+			std::uint8_t lhs;
+			std::uint8_t rhs;
+			std::uint8_t destination;
+		};
+
+		// register program of one kernel, captured by value, the inputs and the outputs hold elements of the kernel type
+		struct FusedProgram {
+			std::array<const void*, max_fused_inputs> inputs;
+			unsigned int inputs_size;
+
+			std::array<void*, max_fused_outputs> outputs;
+			std::array<std::uint8_t, max_fused_outputs> output_operands;
+			unsigned int outputs_size;
+
+			std::array<FusedInstruction, max_fused_instructions> instructions;
+			unsigned int instructions_size;
+			unsigned int registers_size;
+		};
+
+		#define FUSED_UNARY_OP_CASE(NAME, OP) case GALILEO_OP_ ## OP: \
+			if constexpr (NAME::is_supported_type<T>) \
+				for (int k = 0; k < width; ++k) \
+					result[k] = NAME::Apply<T, T>(lhs[k]); \
+			break;
+		#define FUSED_BINARY_OP_CASE(NAME, OP) case GALILEO_OP_ ## OP: \
+			if constexpr (is_fusable_binary<NAME, T>) \
+				for (int k = 0; k < width; ++k) \
+					result[k] = NAME::Apply<T, T>(lhs[k], rhs[k]); \
+			break;
+
+		// one kernel per node type and register file size, the program only picks the ops and the operands
+		// a work-item runs the program over a chunk of elements, so every op is dispatched once per chunk
+		struct FusedElementwiseOp {
+		protected:
+			template <typename T, unsigned int registers_size>
+			void Process(sycl::handler& h) {
+				constexpr auto width = common::vector_width<T>;
+				using Value = std::array<T, width>;
+				const auto program = this->program;
+				const std::size_t size = this->size;
+				const auto chunks = (size + width - 1) / width;
+				h.parallel_for(chunks, [=](sycl::id<1> chunk) {
+					const auto begin = chunk[0] * width;
+					// the last chunk repeats the last element in place of the missing ones
+					auto load = [&](unsigned int input) {
+						const auto input_ptr = static_cast<const T*>(Select(program.inputs, input));
+						Value value;
+						for (int k = 0; k < width; ++k)
+							value[k] = input_ptr[std::min<std::size_t>(begin + k, size - 1)];
+						return value;
+					};
+
+					std::array<Value, registers_size> registers{};
+					auto read = [&](std::uint8_t operand) {
+						return operand < fused_input_operand ? Select(registers, operand) : load(operand - fused_input_operand);
+					};
+					for (unsigned int j = 0; j < program.instructions_size; ++j) {
+						const auto instruction = program.instructions[j];
+						const auto lhs = read(instruction.lhs);
+						const auto rhs = IsBinaryOp(instruction.op) ? read(instruction.rhs) : lhs;
+						Value result{};
+						// the program is the same for every work-item, the branch doesn't diverge
+						switch (instruction.op) {
+						GALILEO_UNARY_OPS(FUSED_UNARY_OP_CASE)
+						GALILEO_BINARY_OPS(FUSED_BINARY_OP_CASE)
+						default:
+							break;
+						}
+						Assign(registers, instruction.destination, result);
+					}
+
+					for (unsigned int j = 0; j < program.outputs_size; ++j) {
+						const auto value = read(Select(program.output_operands, j));
+						const auto output_ptr = static_cast<T*>(Select(program.outputs, j));
+						for (int k = 0; k < width; ++k)
+							if (begin + k < size)
+								output_ptr[begin + k] = value[k];
+					}
+					});
+			}
+
+		public:
+			FusedType data_type;
+			FusedProgram program;
+			unsigned int size;
+
+			// the ops were checked against the node types when the expression was built
+			FusedElementwiseOp(const FusedProgram& program, GALILEO_DATA_TYPE data_type, unsigned int size) :
+				data_type(GetFusedType(data_type)),
+				program(program),
+				size(size) {}
+
+			void operator()(sycl::handler& h) {
+				std::visit([&]<typename T>(T*) {
+					if (program.registers_size <= 4)
+						Process<T, 4>(h);
+					else if (program.registers_size <= 8)
+						Process<T, 8>(h);
+					else
+						Process<T, max_fused_registers>(h);
+				}, data_type);
+			}
+		};
+
+		#undef FUSED_UNARY_OP_CASE
+		#undef FUSED_BINARY_OP_CASE
+
+		// DAG of elementwise ops, node ids are handed out in creation order and are therefore topologically sorted
+		// connected nodes of one type share a kernel, an operand of another type is promoted in between like the standalone ops do
+		class Expression {
+			struct Node {
+				GALILEO_OP op;
+				bool is_input;
+				GALILEO_TENSOR tensor;
+				GALILEO_EXPRESSION_NODE lhs;
+				GALILEO_EXPRESSION_NODE rhs;
+				GALILEO_DATA_TYPE data_type;
+			};
+
+			struct Output {
+				GALILEO_EXPRESSION_NODE node;
+				GALILEO_TENSOR tensor;
+			};
+
+			// fused kernel or promotion, submitted after the steps it reads from
+			struct Step {
+				std::variant<FusedElementwiseOp, CastOp> kernel;
+				std::vector<std::size_t> producers;
+			};
+
+			// a step slot holding the pointer of a bound tensor, the tensor is numbered like in GetTensors
+			struct Binding {
+				enum class Slot { CastInput, ProgramInput, ProgramOutput };
+
+				std::size_t step;
+				Slot slot;
+				unsigned int index;
+				std::size_t tensor;
+			};
+
+			// values passed between the steps, shared with the graphs the steps are captured into
+			struct Scratch {
+				GALILEO_QUEUE queue;
+				std::vector<void*> blocks;
+
+				explicit Scratch(GALILEO_QUEUE queue) : queue(queue) {}
+
+				Scratch(const Scratch&) = delete;
+				Scratch& operator=(const Scratch&) = delete;
+
+				~Scratch() {
+					try {
+						for (auto ptr : blocks)
+							common::ReleaseScratch(queue, ptr);
+					}
+					// a queue released first has freed the blocks with its pool
+					catch (GALILEO_RESULT) {}
+				}
+			};
+
+			GALILEO_QUEUE queue;
+			std::vector<Node> nodes;
+			std::vector<Output> outputs;
+			std::vector<Step> steps;
+			std::vector<Binding> bindings;
+			// kept until the expression is compiled again or released, and by the graphs holding its steps
+			std::shared_ptr<Scratch> scratch;
+			// the next evaluation overwrites the scratch blocks once this one is done with them
+			sycl::event scratch_event;
+			unsigned int compiled_size = 0;
+			bool is_compiled = false;
+
+			static void SetFlatDimensions(GALILEO_TENSOR& tensor, unsigned int size) {
+				tensor.dimensions = {};
+				tensor.dimensions.tensor_dimensions[0] = size;
+				tensor.dimensions.tensor_strides[0] = 1;
+				tensor.dimensions.tensor_dimensions_size = 1;
+			}
+
+			GALILEO_TENSOR MakeScratchTensor(const void* ptr, GALILEO_DATA_TYPE data_type, unsigned int size) const {
+				GALILEO_TENSOR tensor{};
+				tensor.associated_queue = queue;
+				tensor.tensor_data = const_cast<void*>(ptr);
+				tensor.data_type = data_type;
+				SetFlatDimensions(tensor, size);
+				tensor.allocation_kind = GALILEO_ALLOCATION_DEVICE;
+				tensor.validated_data = ptr;
+				return tensor;
+			}
+
+			void* AllocateScratch(GALILEO_DATA_TYPE data_type, unsigned int size) {
+				auto ptr = common::GetQueueContext(queue).pool.Allocate(std::max(size, 1u) * common::GetDataTypeSize(data_type), GALILEO_ALLOCATION_DEVICE);
+				scratch->blocks.push_back(ptr);
+				return ptr;
+			}
+
+			void Compile() {
+				steps.clear();
+				bindings.clear();
+				scratch = std::make_shared<Scratch>(queue);
+				scratch_event = sycl::event();
+
+				std::vector<std::size_t> tensor_indices(nodes.size(), 0);
+				std::size_t inputs_size = 0;
+				for (std::size_t i = 0; i < nodes.size(); ++i)
+					if (nodes[i].is_input)
+						tensor_indices[i] = inputs_size++;
+
+				// union-find over the nodes reachable from the outputs, kernels never span unconnected parts
+				std::vector<unsigned int> components(nodes.size());
+				std::iota(components.begin(), components.end(), 0u);
+				auto find = [&](unsigned int node) {
+					while (components[node] != node)
+						node = components[node] = components[components[node]];
+					return node;
+				};
+
+				std::vector<bool> is_used(nodes.size(), false);
+				std::vector<bool> is_output(nodes.size(), false);
+				for (const auto& output : outputs)
+					is_used[output.node] = is_output[output.node] = true;
+				for (auto i = static_cast<unsigned int>(nodes.size()); i-- > 0;) {
+					const auto& node = nodes[i];
+					if (!is_used[i] || node.is_input)
+						continue;
+					is_used[node.lhs] = true;
+					components[find(node.lhs)] = find(i);
+					if (IsBinaryOp(node.op)) {
+						is_used[node.rhs] = true;
+						components[find(node.rhs)] = find(i);
+					}
+				}
+				for (unsigned int i = 0; i < nodes.size(); ++i)
+					components[i] = find(i);
+
+				// a node moves one stage past an operand of another type, the stages order the kernels
+				std::vector<unsigned int> stages(nodes.size(), 0);
+				auto get_operands = [&](std::size_t i) {
+					const auto& node = nodes[i];
+					return IsBinaryOp(node.op) ? std::vector<GALILEO_EXPRESSION_NODE>{ node.lhs, node.rhs } : std::vector<GALILEO_EXPRESSION_NODE>{ node.lhs };
+				};
+				for (std::size_t i = 0; i < nodes.size(); ++i) {
+					if (!is_used[i] || nodes[i].is_input)
+						continue;
+					for (auto operand : get_operands(i))
+						if (!nodes[operand].is_input)
+							stages[i] = std::max(stages[i], stages[operand] + (nodes[operand].data_type != nodes[i].data_type ? 1 : 0));
+				}
+
+				using GroupKey = std::tuple<unsigned int, unsigned int, GALILEO_DATA_TYPE>;
+				auto get_group = [&](std::size_t i) { return GroupKey{ stages[i], components[i], nodes[i].data_type }; };
+				// inputs only join a kernel when they are an output of it as well
+				std::map<GroupKey, std::vector<GALILEO_EXPRESSION_NODE>> groups;
+				for (std::size_t i = 0; i < nodes.size(); ++i)
+					if (is_used[i] && (!nodes[i].is_input || is_output[i]))
+						groups[get_group(i)].push_back(static_cast<GALILEO_EXPRESSION_NODE>(i));
+
+				// nodes read by another kernel are written to a scratch buffer of their type
+				std::vector<bool> is_materialized(nodes.size(), false);
+				for (std::size_t i = 0; i < nodes.size(); ++i) {
+					if (!is_used[i] || nodes[i].is_input)
+						continue;
+					for (auto operand : get_operands(i))
+						if (!nodes[operand].is_input && get_group(operand) != get_group(i))
+							is_materialized[operand] = true;
+				}
+
+				std::vector<void*> node_buffers(nodes.size(), nullptr);
+				std::vector<std::size_t> node_steps(nodes.size(), 0);
+				std::vector<unsigned int> node_sizes(nodes.size(), 0);
+				std::map<std::pair<GALILEO_EXPRESSION_NODE, GALILEO_DATA_TYPE>, std::pair<void*, std::size_t>> promotions;
+				for (const auto& [key, members] : groups) {
+					const auto data_type = std::get<2>(key);
+					FusedProgram program{};
+					std::vector<std::size_t> producers;
+					// the program is the next step, behind the promotions added for it
+					std::vector<Binding> program_bindings;
+					std::array<std::optional<std::size_t>, max_fused_inputs> input_tensors{};
+					std::optional<unsigned int> size;
+					auto verify_size = [&](unsigned int tensor_size) {
+						if (size && *size != tensor_size)
+							throw GALILEO_RESULT::GALILEO_RESULT_TENSOR_DIMENSIONS_MISMATCH;
+						size = tensor_size;
+					};
+					// fused kernels address every tensor linearly
+					auto verify_tensor = [&](const GALILEO_TENSOR& tensor) {
+						if (!common::IsContiguous(tensor.dimensions))
+							throw GALILEO_RESULT::GALILEO_RESULT_TENSOR_DIMENSIONS_MISMATCH;
+						verify_size(common::GetTotalSize(tensor.dimensions));
+					};
+
+					// values of an operand from outside the kernel in the type of the kernel, and the input tensor they are read from directly
+					auto get_buffer = [&](GALILEO_EXPRESSION_NODE operand) -> std::pair<const void*, std::optional<std::size_t>> {
+						const auto& node = nodes[operand];
+						const void* buffer = node.is_input ? node.tensor.tensor_data : node_buffers[operand];
+						std::optional<std::size_t> producer;
+						if (node.is_input)
+							verify_tensor(node.tensor);
+						else {
+							verify_size(node_sizes[operand]);
+							producer = node_steps[operand];
+						}
+
+						if (node.data_type != data_type) {
+							auto it = promotions.find({ operand, data_type });
+							if (it == promotions.end()) {
+								auto promoted = AllocateScratch(data_type, *size);
+								const auto source = MakeScratchTensor(buffer, node.data_type, *size);
+								auto destination = MakeScratchTensor(promoted, data_type, *size);
+								if (node.is_input)
+									bindings.push_back(Binding{ steps.size(), Binding::Slot::CastInput, 0, tensor_indices[operand] });
+								steps.push_back(Step{ CastOp(source, destination, GALILEO_ROUNDING_NEAREST_EVEN, false), producer ? std::vector<std::size_t>{ *producer } : std::vector<std::size_t>{} });
+								it = promotions.emplace(std::pair{ operand, data_type }, std::pair{ promoted, steps.size() - 1 }).first;
+							}
+							buffer = it->second.first;
+							producer = it->second.second;
+						}
+						if (producer && std::find(producers.begin(), producers.end(), *producer) == producers.end())
+							producers.push_back(*producer);
+						return { buffer, node.is_input && node.data_type == data_type ? std::optional<std::size_t>(tensor_indices[operand]) : std::nullopt };
+					};
+					// inputs bound to one buffer now may be bound to different ones later, so they only share a slot when it's the same tensor
+					auto get_input_operand = [&](GALILEO_EXPRESSION_NODE operand) {
+						const auto [buffer, tensor] = get_buffer(operand);
+						for (unsigned int j = 0; j < program.inputs_size; ++j)
+							if (program.inputs[j] == buffer && input_tensors[j] == tensor)
+								return static_cast<std::uint8_t>(fused_input_operand + j);
+						if (program.inputs_size == max_fused_inputs)
+							throw GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+						if (tensor)
+							program_bindings.push_back(Binding{ 0, Binding::Slot::ProgramInput, program.inputs_size, *tensor });
+						program.inputs[program.inputs_size] = buffer;
+						input_tensors[program.inputs_size] = tensor;
+						return static_cast<std::uint8_t>(fused_input_operand + program.inputs_size++);
+					};
+
+					auto is_member = [&](GALILEO_EXPRESSION_NODE node) { return !nodes[node].is_input && get_group(node) == key; };
+					// outputs of the kernel keep their registers until the end of the program
+					std::vector<std::size_t> last_use(nodes.size(), 0);
+					for (auto i : members) {
+						if (nodes[i].is_input)
+							continue;
+						for (auto operand : get_operands(i))
+							if (is_member(operand))
+								last_use[operand] = i;
+						if (is_output[i] || is_materialized[i])
+							last_use[i] = nodes.size();
+					}
+
+					std::vector<std::uint8_t> registers(nodes.size());
+					std::vector<std::uint8_t> free_registers;
+					auto allocate_register = [&]() -> std::uint8_t {
+						if (!free_registers.empty()) {
+							auto reg = free_registers.back();
+							free_registers.pop_back();
+							return reg;
+						}
+						if (program.registers_size == max_fused_registers)
+							throw GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+						return static_cast<std::uint8_t>(program.registers_size++);
+					};
+					auto get_operand = [&](GALILEO_EXPRESSION_NODE node) {
+						return is_member(node) ? registers[node] : get_input_operand(node);
+					};
+
+					for (auto i : members) {
+						const auto& node = nodes[i];
+						if (node.is_input)
+							continue;
+						if (program.instructions_size == max_fused_instructions)
+							throw GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+						const auto lhs = get_operand(node.lhs);
+						const auto rhs = IsBinaryOp(node.op) ? get_operand(node.rhs) : lhs;
+						// operands are released first so the result may reuse their register
+						const auto operands = get_operands(i);
+						for (std::size_t j = 0; j < operands.size(); ++j)
+							if (is_member(operands[j]) && last_use[operands[j]] == i && (j == 0 || operands[j] != operands[0]))
+								free_registers.push_back(registers[operands[j]]);
+						registers[i] = allocate_register();
+						program.instructions[program.instructions_size++] = FusedInstruction{ node.op, lhs, rhs, registers[i] };
+					}
+					if (!size)
+						throw GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+					auto add_output = [&](void* ptr, std::uint8_t operand) {
+						if (program.outputs_size == max_fused_outputs)
+							throw GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+						program.outputs[program.outputs_size] = ptr;
+						program.output_operands[program.outputs_size] = operand;
+						++program.outputs_size;
+					};
+					for (std::size_t j = 0; j < outputs.size(); ++j) {
+						const auto& output = outputs[j];
+						if (get_group(output.node) != key)
+							continue;
+						verify_tensor(output.tensor);
+						program_bindings.push_back(Binding{ 0, Binding::Slot::ProgramOutput, program.outputs_size, inputs_size + j });
+						add_output(output.tensor.tensor_data, get_operand(output.node));
+					}
+					for (auto i : members) {
+						if (!is_materialized[i])
+							continue;
+						node_buffers[i] = AllocateScratch(data_type, *size);
+						node_steps[i] = steps.size();
+						node_sizes[i] = *size;
+						add_output(node_buffers[i], registers[i]);
+					}
+
+					for (auto& binding : program_bindings) {
+						binding.step = steps.size();
+						bindings.push_back(binding);
+					}
+					steps.push_back(Step{ FusedElementwiseOp(program, data_type, *size), producers });
+					compiled_size = *size;
+				}
+				is_compiled = true;
+			}
+
+			void Retarget(const Binding& binding, void* ptr) {
+				std::visit([&](auto& kernel) {
+					using Kernel = std::decay_t<decltype(kernel)>;
+					if constexpr (std::is_same_v<Kernel, CastOp>)
+						std::visit([&]<typename T>(const T*) { kernel.input = static_cast<const T*>(ptr); }, kernel.input);
+					else if (binding.slot == Binding::Slot::ProgramInput)
+						kernel.program.inputs[binding.index] = ptr;
+					else
+						kernel.program.outputs[binding.index] = ptr;
+					}, steps[binding.step].kernel);
+			}
+
+			void VerifyNode(GALILEO_EXPRESSION_NODE node) const {
+				if (node >= nodes.size())
+					throw GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+			}
+
+		public:
+			explicit Expression(GALILEO_QUEUE queue) : queue(queue) {}
+
+			// copies the description only, the copy compiles its own kernels and holds its own scratch blocks
+			Expression(const Expression& other) : queue(other.queue), nodes(other.nodes), outputs(other.outputs) {}
+			Expression& operator=(const Expression&) = delete;
+
+			GALILEO_QUEUE GetQueue() const {
+				return queue;
+			}
+
+			// the input tensors in node order, then the outputs
+			std::vector<GALILEO_TENSOR> GetTensors() const {
+				std::vector<GALILEO_TENSOR> tensors;
+				for (const auto& node : nodes)
+					if (node.is_input)
+						tensors.push_back(node.tensor);
+				for (const auto& output : outputs)
+					tensors.push_back(output.tensor);
+				return tensors;
+			}
+
+			GALILEO_EXPRESSION_NODE AddInput(const GALILEO_TENSOR& tensor) {
+				// rejects types no kernel is built for
+				GetFusedType(tensor.data_type);
+				nodes.push_back(Node{ GALILEO_OP_ABS, true, tensor, 0, 0, tensor.data_type });
+				is_compiled = false;
+				return static_cast<GALILEO_EXPRESSION_NODE>(nodes.size() - 1);
+			}
+
+			GALILEO_EXPRESSION_NODE AddOp(GALILEO_OP op, GALILEO_EXPRESSION_NODE lhs, GALILEO_EXPRESSION_NODE rhs) {
+				VerifyNode(lhs);
+				VerifyNode(rhs);
+				const auto data_type = GetNodeDataType(op, nodes[lhs].data_type, nodes[rhs].data_type);
+				nodes.push_back(Node{ op, false, GALILEO_TENSOR(), lhs, rhs, data_type });
+				is_compiled = false;
+				return static_cast<GALILEO_EXPRESSION_NODE>(nodes.size() - 1);
+			}
+
+			// the output takes the type of its node, as the standalone op requires
+			void AddOutput(GALILEO_EXPRESSION_NODE node, const GALILEO_TENSOR& tensor) {
+				VerifyNode(node);
+				if (tensor.data_type != nodes[node].data_type)
+					throw GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE;
+				outputs.push_back(Output{ node, tensor });
+				is_compiled = false;
+			}
+
+			// data types of the input nodes in creation order and of the outputs in the order they were added
+			std::vector<GALILEO_DATA_TYPE> GetInputTypes() const {
+				std::vector<GALILEO_DATA_TYPE> types;
+				for (const auto& node : nodes)
+					if (node.is_input)
+						types.push_back(node.tensor.data_type);
+				return types;
+			}
+
+			std::vector<GALILEO_DATA_TYPE> GetOutputTypes() const {
+				std::vector<GALILEO_DATA_TYPE> types;
+				for (const auto& output : outputs)
+					types.push_back(output.tensor.data_type);
+				return types;
+			}
+
+			// points the inputs and the outputs, in the order above, at contiguous buffers of size elements
+			// compiled steps are only retargeted, up to the size they were compiled for, so the kernels and the scratch blocks are kept
+			void Bind(const std::vector<void*>& inputs, const std::vector<void*>& outputs, unsigned int size) {
+				auto bind = [size](GALILEO_TENSOR& tensor, void* ptr) {
+					tensor.tensor_data = ptr;
+					tensor.validated_data = ptr;
+					SetFlatDimensions(tensor, size);
+				};
+				auto input = inputs.begin();
+				for (auto& node : nodes)
+					if (node.is_input)
+						bind(node.tensor, *input++);
+				for (std::size_t i = 0; i < this->outputs.size(); ++i)
+					bind(this->outputs[i].tensor, outputs[i]);
+				if (!is_compiled || size > compiled_size) {
+					is_compiled = false;
+					return;
+				}
+
+				for (auto& step : steps)
+					std::visit([size](auto& kernel) { kernel.size = size; }, step.kernel);
+				for (const auto& binding : bindings)
+					Retarget(binding, binding.tensor < inputs.size() ? inputs[binding.tensor] : outputs[binding.tensor - inputs.size()]);
+			}
+
+			sycl::event Evaluate(const std::vector<sycl::event>& dependencies) {
+				if (!is_compiled)
+					Compile();
+
+				auto evaluate_dependencies = dependencies;
+				if (!scratch->blocks.empty())
+					evaluate_dependencies.push_back(scratch_event);
+				std::vector<sycl::event> events;
+				for (auto& step : steps) {
+					auto step_dependencies = evaluate_dependencies;
+					for (auto producer : step.producers)
+						step_dependencies.push_back(events[producer]);
+					// a captured step keeps the scratch blocks it reads and writes alive, the expression may be compiled again or released first
+					events.push_back(std::visit([&](const auto& kernel) {
+						auto submit = [kernel, scratch = scratch](sycl::handler& h) mutable { kernel(h); };
+						return common::Submit(queue, submit, step_dependencies);
+						}, step.kernel));
+				}
+				auto event = events.size() == 1 ? events.front() : common::SubmitBarrier(queue, events.empty() ? dependencies : events);
+				if (!scratch->blocks.empty())
+					scratch_event = event;
+				return event;
+			}
+		};
+
+		inline auto& GetExpression(GALILEO_EXPRESSION expression) {
+			return *reinterpret_cast<Expression*>(expression);
+		}
+	}
+}
@@ -1,4 +1,5 @@
 #include "common.hpp"
+#include "context.hpp"
 
 GALILEO_RESULT GALILEO_GetLibVersion(unsigned int* major, unsigned int* minor, unsigned int* patch) {
 	if (!major || !minor || !patch)
@@ -18,29 +19,237 @@ GALILEO_RESULT GALILEO_GetQueueSize(unsigned int* size) {
 	return GALILEO_RESULT::GALILEO_RESULT_OK;
 }
 GALILEO_RESULT GALILEO_InitQueue(GALILEO_QUEUE queue) {
+	return GALILEO_InitQueueEx(queue, nullptr);
+}
+
+namespace {
+	GALILEO_DEVICE_TYPE GetDeviceType(sycl::info::device_type device_type) {
+		switch (device_type) {
+		case sycl::info::device_type::cpu:
+			return GALILEO_DEVICE_CPU;
+		case sycl::info::device_type::gpu:
+			return GALILEO_DEVICE_GPU;
+		case sycl::info::device_type::accelerator:
+			return GALILEO_DEVICE_ACCELERATOR;
+		default:
+			return GALILEO_DEVICE_ANY;
+		}
+	}
+
+	sycl::info::device_type GetSyclDeviceType(GALILEO_DEVICE_TYPE device_type) {
+		switch (device_type) {
+		case GALILEO_DEVICE_ANY:
+			return sycl::info::device_type::all;
+		case GALILEO_DEVICE_CPU:
+			return sycl::info::device_type::cpu;
+		case GALILEO_DEVICE_GPU:
+			return sycl::info::device_type::gpu;
+		case GALILEO_DEVICE_ACCELERATOR:
+			return sycl::info::device_type::accelerator;
+		default:
+			throw GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+		}
+	}
+
+	sycl::device SelectDevice(const GALILEO_QUEUE_PROPERTIES& properties) {
+		if (properties.device_type == GALILEO_DEVICE_DEFAULT)
+			return sycl::device{ sycl::default_selector_v };
+
+		const auto devices = sycl::device::get_devices(GetSyclDeviceType(properties.device_type));
+		if (properties.device_index >= devices.size())
+			throw GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+		return devices[properties.device_index];
+	}
+
+	template <std::size_t size>
+	void CopyString(const std::string& source, char(&destination)[size]) {
+		const auto length = std::min(source.size(), size - 1);
+		std::copy_n(source.begin(), length, destination);
+		destination[length] = '\0';
+	}
+}
+
+// the queue is still constructed in the caller's buffer of GALILEO_GetQueueSize bytes, the properties only pick its constructor arguments
+// discard_events is accepted as a hint only, the memory pool tells idle blocks by the events of the submissions
+GALILEO_RESULT GALILEO_InitQueueEx(GALILEO_QUEUE queue, const GALILEO_QUEUE_PROPERTIES* properties) {
 	if (!queue)
 		return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
-	
-	new (queue) sycl::queue();
-	return GALILEO_RESULT::GALILEO_RESULT_OK;	
+
+	try {
+		const auto queue_properties = properties ? *properties : GALILEO_QUEUE_PROPERTIES{};
+		const auto device = SelectDevice(queue_properties);
+		// GALILEO_PROFILING asks for the device times as well
+		const auto enable_profiling = queue_properties.enable_profiling || galileo::common::Profiler::IsEnabledByEnvironment();
+		if (queue_properties.in_order && enable_profiling)
+			new (queue) sycl::queue(device, { sycl::property::queue::in_order(), sycl::property::queue::enable_profiling() });
+		else if (queue_properties.in_order)
+			new (queue) sycl::queue(device, { sycl::property::queue::in_order() });
+		else if (enable_profiling)
+			new (queue) sycl::queue(device, { sycl::property::queue::enable_profiling() });
+		else
+			new (queue) sycl::queue(device);
+		galileo::common::GetQueueContextRegistry().Create(queue);
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+	return GALILEO_RESULT::GALILEO_RESULT_OK;
 }
 
-GALILEO_RESULT GALILEO_ReleaseQueue(GALILEO_QUEUE queue) {
+// with devices set to nullptr only the number of devices is returned, otherwise up to *count devices are filled in and *count is updated
+GALILEO_RESULT GALILEO_EnumerateDevices(GALILEO_DEVICE_INFO* devices, unsigned int* count) {
+	if (!count)
+		return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+	try {
+		const auto sycl_devices = sycl::device::get_devices();
+		if (!devices) {
+			*count = static_cast<unsigned int>(sycl_devices.size());
+			return GALILEO_RESULT::GALILEO_RESULT_OK;
+		}
+
+		// the index of a device counts the preceding devices of its type, the order sycl::device::get_devices keeps for every type
+		std::array<unsigned int, GALILEO_DEVICE_ACCELERATOR + 1> type_indices{};
+		const auto devices_size = std::min<std::size_t>(*count, sycl_devices.size());
+		for (std::size_t i = 0; i < devices_size; ++i) {
+			const auto& device = sycl_devices[i];
+			auto& info = devices[i];
+			info.device_type = GetDeviceType(device.get_info<sycl::info::device::device_type>());
+			info.device_index = info.device_type == GALILEO_DEVICE_ANY ? static_cast<unsigned int>(i) : type_indices[info.device_type]++;
+			CopyString(device.get_info<sycl::info::device::name>(), info.name);
+			CopyString(device.get_info<sycl::info::device::vendor>(), info.vendor);
+			info.compute_units = device.get_info<sycl::info::device::max_compute_units>();
+			info.global_memory_bytes = device.get_info<sycl::info::device::global_mem_size>();
+		}
+		*count = static_cast<unsigned int>(devices_size);
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+	return GALILEO_RESULT::GALILEO_RESULT_OK;
+}
+
+namespace {
+	std::vector<sycl::device> GetShardDevices(const sycl::device& device, GALILEO_SHARDING sharding) {
+		switch (sharding) {
+		case GALILEO_SHARDING_NUMA:
+			// devices without affinity domains aren't partitioned
+			try {
+				return device.create_sub_devices<sycl::info::partition_property::partition_by_affinity_domain>(sycl::info::partition_affinity_domain::numa);
+			}
+			catch (const sycl::exception&) {
+				return {};
+			}
+		case GALILEO_SHARDING_DEVICES:
+			return device.get_platform().get_devices();
+		default:
+			throw GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+		}
+	}
+}
+
+// the queue stays on the default device, the shards share its context so that every shard reaches the host and shared allocations
+// a single shard leaves a plain queue
+GALILEO_RESULT GALILEO_InitShardedQueue(GALILEO_QUEUE queue, GALILEO_SHARDING sharding) {
 	if (!queue)
 		return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
-	
-	using T = sycl::queue;
-	auto& typed_queue = galileo::common::GetQueue(queue);
-	typed_queue.wait();
-	typed_queue.~T();
-	return GALILEO_RESULT::GALILEO_RESULT_OK;	
+
+	try {
+		const sycl::device device{ sycl::default_selector_v };
+		const auto shard_devices = GetShardDevices(device, sharding);
+		if (shard_devices.size() < 2)
+			return GALILEO_InitQueue(queue);
+
+		auto context_devices = shard_devices;
+		if (sharding == GALILEO_SHARDING_NUMA)
+			context_devices.push_back(device);
+		const sycl::context context(context_devices);
+		new (queue) sycl::queue(context, device);
+		galileo::common::GetQueueContextRegistry().Create(queue);
+
+		auto& queue_context = galileo::common::GetQueueContext(queue);
+		for (const auto& shard_device : shard_devices)
+			queue_context.shards.emplace_back(context, shard_device);
+		queue_context.is_multi_device = sharding == GALILEO_SHARDING_DEVICES;
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+	return GALILEO_RESULT::GALILEO_RESULT_OK;
+}
+
+GALILEO_RESULT GALILEO_GetShardCount(GALILEO_QUEUE queue, unsigned int* count) {
+	try {
+		if (!queue || !count)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		const auto& shards = galileo::common::GetQueueContext(queue).shards;
+		*count = shards.empty() ? 1 : static_cast<unsigned int>(shards.size());
+		return GALILEO_RESULT::GALILEO_RESULT_OK;
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+}
+
+GALILEO_RESULT GALILEO_ReleaseQueue(GALILEO_QUEUE queue) {
+	try {
+		if (!queue)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		using T = sycl::queue;
+		auto& typed_queue = galileo::common::GetQueue(queue);
+		typed_queue.wait();
+		for (auto& shard : galileo::common::GetQueueContext(queue).shards)
+			shard.wait();
+		galileo::common::GetQueueContextRegistry().Release(queue);
+		typed_queue.~T();
+		return GALILEO_RESULT::GALILEO_RESULT_OK;
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
 }
 
 GALILEO_RESULT GALILEO_Allocate(GALILEO_QUEUE queue, GALILEO_DATA_TYPE data_type, unsigned size, void** ptr) {
+	return GALILEO_AllocateEx(queue, data_type, size, GALILEO_ALLOCATION_SHARED, ptr);
+}
+
+GALILEO_RESULT GALILEO_AllocateEx(GALILEO_QUEUE queue, GALILEO_DATA_TYPE data_type, unsigned int size, GALILEO_ALLOCATION_KIND allocation_kind, void** ptr) {
 	try {
 		if (!queue|| !ptr)
 			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
-		*ptr = galileo::common::TypeErasedAllocate(galileo::common::GetQueue(queue), data_type, size);
+		const auto bytes = galileo::common::GetDataTypeSize(data_type) * size;
+		auto& context = galileo::common::GetQueueContext(queue);
+		*ptr = context.pool.Allocate(bytes, allocation_kind, true);
+		context.registry.Register(*ptr, bytes, allocation_kind);
+		// pages land on the node touching them first, so the part of every shard is touched by the shard itself
+		if (allocation_kind != GALILEO_ALLOCATION_DEVICE && galileo::common::GetShardCount(queue, size) > 1) {
+			const auto shards_size = context.shards.size();
+			std::vector<sycl::event> events;
+			for (std::size_t shard = 0; shard < shards_size; ++shard) {
+				const auto begin = galileo::common::GetShardBegin(bytes, shard, shards_size);
+				const auto end = galileo::common::GetShardBegin(bytes, shard + 1, shards_size);
+				auto memset = [part = static_cast<std::byte*>(*ptr) + begin, part_size = end - begin](sycl::handler& h) { h.memset(part, 0, part_size); };
+				events.push_back(galileo::common::SubmitShard(queue, shard, memset, {}));
+			}
+			sycl::event::wait_and_throw(events);
+		}
 		return GALILEO_RESULT::GALILEO_RESULT_OK;
 	}
 	catch(GALILEO_RESULT result) {
@@ -52,27 +261,362 @@ GALILEO_RESULT GALILEO_Allocate(GALILEO_QUEUE queue, GALILEO_DATA_TYPE data_type
 }
 
 GALILEO_RESULT GALILEO_Deallocate(GALILEO_QUEUE queue, void* ptr) {
-	if (!queue|| !ptr)
-		return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+	try {
+		if (!queue|| !ptr)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
 
-	sycl::free(ptr, galileo::common::GetQueue(queue));
-	return GALILEO_RESULT::GALILEO_RESULT_OK;
+		auto& context = galileo::common::GetQueueContext(queue);
+		context.registry.Unregister(ptr);
+		// memory that didn't come from the pool is released right away
+		if (!context.pool.Deallocate(ptr))
+			sycl::free(ptr, galileo::common::GetQueue(queue));
+		return GALILEO_RESULT::GALILEO_RESULT_OK;
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+}
+
+GALILEO_RESULT GALILEO_TrimPool(GALILEO_QUEUE queue) {
+	try {
+		if (!queue)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		galileo::common::GetQueueContext(queue).pool.Trim();
+		return GALILEO_RESULT::GALILEO_RESULT_OK;
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+}
+
+// unary and binary ops up to elements elements run on the calling thread when the queue runs on the CPU, 0 turns it off
+GALILEO_RESULT GALILEO_SetHostThreshold(GALILEO_QUEUE queue, unsigned int elements) {
+	try {
+		if (!queue)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		galileo::common::GetQueueContext(queue).host_threshold = elements;
+		return GALILEO_RESULT::GALILEO_RESULT_OK;
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+}
+
+GALILEO_RESULT GALILEO_GetPoolStatistics(GALILEO_QUEUE queue, GALILEO_POOL_STATISTICS* statistics) {
+	try {
+		if (!queue || !statistics)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		*statistics = galileo::common::GetQueueContext(queue).pool.GetStatistics();
+		return GALILEO_RESULT::GALILEO_RESULT_OK;
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+}
+
+GALILEO_RESULT GALILEO_RegisterPointer(GALILEO_QUEUE queue, void* ptr, size_t size) {
+	try {
+		if (!queue || !ptr)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		// the runtime is queried once here instead of on every call that uses the pointer
+		const auto usm_kind = sycl::get_pointer_type(ptr, galileo::common::GetQueue(queue).get_context());
+		if (usm_kind == sycl::usm::alloc::unknown)
+			return GALILEO_RESULT::GALILEO_RESULT_NON_USM_POINTER;
+
+		galileo::common::GetQueueContext(queue).registry.Register(ptr, size, galileo::common::GetAllocationKind(usm_kind));
+		return GALILEO_RESULT::GALILEO_RESULT_OK;
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+}
+
+GALILEO_RESULT GALILEO_UnregisterPointer(GALILEO_QUEUE queue, void* ptr) {
+	try {
+		if (!queue || !ptr)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		if (!galileo::common::GetQueueContext(queue).registry.Unregister(ptr))
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+		return GALILEO_RESULT::GALILEO_RESULT_OK;
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+}
+
+// memory of other allocators is used in place by devices reaching system allocations and by CPU devices, which run in the host process
+// the others get a device copy, filled here and written back by GALILEO_UnregisterHostMemory, so the copies can't be captured
+// a mode of GALILEO_HOST_MEMORY_IMPORTED on input asks for the in-place use only and fails instead of mirroring
+GALILEO_RESULT GALILEO_RegisterHostMemory(GALILEO_QUEUE queue, void* ptr, size_t size, GALILEO_HOST_MEMORY_MODE* mode) {
+	try {
+		if (!queue || !ptr || !size)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		auto& context = galileo::common::GetQueueContext(queue);
+		auto& sycl_queue = galileo::common::GetQueue(queue);
+		const auto is_mirror_allowed = !mode || *mode == GALILEO_HOST_MEMORY_MIRRORED;
+		auto set_mode = [mode](GALILEO_HOST_MEMORY_MODE value) {
+			if (mode)
+				*mode = value;
+		};
+		const auto usm_kind = sycl::get_pointer_type(ptr, sycl_queue.get_context());
+		if (usm_kind != sycl::usm::alloc::unknown) {
+			context.registry.Register(ptr, size, galileo::common::GetAllocationKind(usm_kind));
+			set_mode(GALILEO_HOST_MEMORY_IMPORTED);
+			return GALILEO_RESULT::GALILEO_RESULT_OK;
+		}
+		const auto device = sycl_queue.get_device();
+		if (device.has(sycl::aspect::usm_system_allocations) || device.is_cpu()) {
+			context.registry.Register(ptr, size, GALILEO_ALLOCATION_HOST);
+			set_mode(GALILEO_HOST_MEMORY_IMPORTED);
+			return GALILEO_RESULT::GALILEO_RESULT_OK;
+		}
+		if (!is_mirror_allowed)
+			return GALILEO_RESULT::GALILEO_RESULT_NON_USM_POINTER;
+		if (context.capture)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		auto mirror = context.pool.Allocate(size, GALILEO_ALLOCATION_DEVICE);
+		try {
+#ifdef SYCL_EXT_ONEAPI_COPY_OPTIMIZE
+			// pinned for the copies in and out
+			sycl::ext::oneapi::experimental::prepare_for_device_copy(ptr, size, sycl_queue);
+#endif
+			auto copy = [=](sycl::handler& h) { h.memcpy(mirror, ptr, size); };
+			galileo::common::Submit(queue, copy, {}).wait_and_throw();
+		}
+		catch (...) {
+			context.pool.Deallocate(mirror);
+			throw;
+		}
+		context.registry.Register(mirror, size, GALILEO_ALLOCATION_DEVICE);
+		context.mirrors.Register(ptr, size, mirror);
+		set_mode(GALILEO_HOST_MEMORY_MIRRORED);
+		return GALILEO_RESULT::GALILEO_RESULT_OK;
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+}
+
+// the tensors created on the memory must not be used afterwards, a device copy is written back once the queue is idle
+// and can't be while the queue is captured
+GALILEO_RESULT GALILEO_UnregisterHostMemory(GALILEO_QUEUE queue, void* ptr) {
+	try {
+		if (!queue || !ptr)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		auto& context = galileo::common::GetQueueContext(queue);
+		auto& sycl_queue = galileo::common::GetQueue(queue);
+		if (context.capture && context.mirrors.Translate(ptr))
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+		const auto entry = context.mirrors.Unregister(ptr);
+		if (!entry) {
+			if (!context.registry.Unregister(ptr))
+				return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+			return GALILEO_RESULT::GALILEO_RESULT_OK;
+		}
+
+		sycl_queue.wait();
+		for (auto& shard : context.shards)
+			shard.wait();
+		auto copy = [destination = ptr, source = entry->mirror, size = entry->size](sycl::handler& h) { h.memcpy(destination, source, size); };
+		galileo::common::Submit(queue, copy, {}).wait_and_throw();
+#ifdef SYCL_EXT_ONEAPI_COPY_OPTIMIZE
+		sycl::ext::oneapi::experimental::release_from_device_copy(ptr, sycl_queue);
+#endif
+		context.registry.Unregister(entry->mirror);
+		context.pool.Deallocate(entry->mirror);
+		return GALILEO_RESULT::GALILEO_RESULT_OK;
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
 }
 
 GALILEO_RESULT GALILEO_Create1dTensor(GALILEO_QUEUE queue, void* ptr, GALILEO_DATA_TYPE data_type, unsigned int size, GALILEO_TENSOR* tensor) {
-	if (!queue || !ptr || !tensor)
-		return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+	return GALILEO_CreateNdTensor(queue, ptr, data_type, &size, nullptr, 1, tensor);
+}
+
+GALILEO_RESULT GALILEO_CreateNdTensor(GALILEO_QUEUE queue, void* ptr, GALILEO_DATA_TYPE data_type, const unsigned int* dimensions, const unsigned int* strides, unsigned int dimensions_size, GALILEO_TENSOR* tensor) {
+	try {
+		if (!queue || !ptr || !tensor || !dimensions)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+		if (dimensions_size == 0 || dimensions_size > GALILEO_MAX_TENSOR_DIMENSIONS)
+			return GALILEO_RESULT::GALILEO_RESULT_TENSOR_DIMENSIONS_MISMATCH;
 
-	// consider creating some conversion function on receiving host pointer
-	// todo: or should it be handled by the C++ header-only interface?
-	if (!galileo::common::VerifyPtr(galileo::common::GetQueue(queue), ptr))
-		return GALILEO_RESULT::GALILEO_RESULT_NON_USM_POINTER;
+		auto& context = galileo::common::GetQueueContext(queue);
+		auto data = ptr;
+		auto allocation_kind = galileo::common::GetPointerKind(queue, ptr);
+		auto remaining_size = context.registry.GetRemainingSize(ptr);
+		// mirrored host memory is swapped for its device copy
+		if (!allocation_kind) {
+			data = context.mirrors.Translate(ptr);
+			if (!data)
+				return GALILEO_RESULT::GALILEO_RESULT_NON_USM_POINTER;
+			allocation_kind = GALILEO_ALLOCATION_DEVICE;
+			remaining_size = context.mirrors.GetRemainingSize(ptr);
+		}
 
-	tensor->associated_queue = queue;
-	tensor->tensor_data = ptr;
-	tensor->data_type = data_type;
-	tensor->dimensions.tensor_dimensions_size = 1;
-	tensor->dimensions.tensor_dimensions[0] = size;
+		tensor->associated_queue = queue;
+		tensor->tensor_data = data;
+		tensor->data_type = data_type;
+		tensor->dimensions.tensor_dimensions_size = dimensions_size;
+		// no strides stand for the contiguous row-major layout
+		unsigned int contiguous_stride = 1;
+		for (auto i = dimensions_size; i-- > 0;) {
+			tensor->dimensions.tensor_dimensions[i] = dimensions[i];
+			tensor->dimensions.tensor_strides[i] = strides ? strides[i] : contiguous_stride;
+			contiguous_stride *= dimensions[i];
+		}
+		// the furthest element has to lie inside the allocation, the size of memory unknown to the registry can't be checked
+		if (remaining_size && galileo::common::GetTensorBytes(*tensor) > *remaining_size)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+		tensor->allocation_kind = *allocation_kind;
+		tensor->validated_data = data;
 
-	return GALILEO_RESULT::GALILEO_RESULT_OK;
+		return GALILEO_RESULT::GALILEO_RESULT_OK;
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
 }
+
+GALILEO_RESULT GALILEO_MemcpyAsync(GALILEO_QUEUE queue, void* dst, const void* src, size_t size, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event) {
+	try {
+		if (!queue || !dst || !src)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		auto dependencies = galileo::common::GetEvents(wait_events, wait_events_size);
+		auto copy = [=](sycl::handler& h) { h.memcpy(dst, src, size); };
+		galileo::common::SetEvent(event, galileo::common::Submit(queue, copy, dependencies));
+		return GALILEO_RESULT::GALILEO_RESULT_OK;
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+}
+
+GALILEO_RESULT GALILEO_Memcpy(GALILEO_QUEUE queue, void* dst, const void* src, size_t size) {
+	GALILEO_EVENT event = nullptr;
+	auto result = GALILEO_MemcpyAsync(queue, dst, src, size, nullptr, 0, &event);
+	if (result != GALILEO_RESULT::GALILEO_RESULT_OK)
+		return result;
+
+	result = GALILEO_WaitEvents(&event, 1);
+	GALILEO_ReleaseEvent(event);
+	return result;
+}
+
+GALILEO_RESULT GALILEO_Prefetch(const GALILEO_TENSOR* tensor) {
+	try {
+		if (!tensor || !tensor->tensor_data)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		// only shared allocations migrate, the other kinds are already where they are going to stay
+		if (tensor->allocation_kind != GALILEO_ALLOCATION_SHARED)
+			return GALILEO_RESULT::GALILEO_RESULT_OK;
+
+		const auto ptr = tensor->tensor_data;
+		const auto size = galileo::common::GetTensorBytes(*tensor);
+		auto prefetch = [=](sycl::handler& h) { h.prefetch(ptr, size); };
+		galileo::common::Submit(tensor->associated_queue, prefetch, {});
+		return GALILEO_RESULT::GALILEO_RESULT_OK;
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+}
+
+GALILEO_RESULT GALILEO_MemAdvise(const GALILEO_TENSOR* tensor, int advice) {
+	try {
+		if (!tensor || !tensor->tensor_data)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		const auto ptr = tensor->tensor_data;
+		const auto size = galileo::common::GetTensorBytes(*tensor);
+		auto mem_advise = [=](sycl::handler& h) { h.mem_advise(ptr, size, advice); };
+		galileo::common::Submit(tensor->associated_queue, mem_advise, {});
+		return GALILEO_RESULT::GALILEO_RESULT_OK;
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+}
+
+GALILEO_RESULT GALILEO_QueueWait(GALILEO_QUEUE queue) {
+	try {
+		if (!queue)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		galileo::common::GetQueue(queue).wait();
+		for (auto& shard : galileo::common::GetQueueContext(queue).shards)
+			shard.wait();
+		return GALILEO_RESULT::GALILEO_RESULT_OK;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+}
+
+GALILEO_RESULT GALILEO_WaitEvents(const GALILEO_EVENT* events, unsigned int events_size) {
+	try {
+		sycl::event::wait(galileo::common::GetEvents(events, events_size));
+		return GALILEO_RESULT::GALILEO_RESULT_OK;
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+}
+
+GALILEO_RESULT GALILEO_ReleaseEvent(GALILEO_EVENT event) {
+	if (!event)
+		return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+	delete &galileo::common::GetEvent(event);
+	return GALILEO_RESULT::GALILEO_RESULT_OK;
+}
\ No newline at end of file
@@ -1,6 +1,8 @@
 #ifndef GALILEO_H_
 #define GALILEO_H_
 
+#include <stddef.h>
+
 typedef enum tagGALILEO_RESULT {
 	GALILEO_RESULT_OK,
 	GALILEO_RESULT_INVALID_FUNC_PARAMETER,
@@ -25,22 +27,177 @@ typedef enum tagGALILEO_DATA_TYPE {
 	GALILEO_HALF,
 	GALILEO_COMPLEX_FLOAT,
 	GALILEO_COMPLEX_DOUBLE,
-	GALILEO_COMPLEX_HALF
+	GALILEO_COMPLEX_HALF,
+	GALILEO_BFLOAT16
 } GALILEO_DATA_TYPE;
 
+typedef enum tagGALILEO_ALLOCATION_KIND {
+	GALILEO_ALLOCATION_SHARED = 0,
+	GALILEO_ALLOCATION_DEVICE,
+	GALILEO_ALLOCATION_HOST
+} GALILEO_ALLOCATION_KIND;
+
+typedef enum tagGALILEO_HOST_MEMORY_MODE {
+	GALILEO_HOST_MEMORY_IMPORTED = 0, /* used in place, the results are there once the ops are waited for; as an input, nothing else is accepted */
+	GALILEO_HOST_MEMORY_MIRRORED /* tensors run on a device copy, the results are written back by GALILEO_UnregisterHostMemory; as an input, allowed as a fallback */
+} GALILEO_HOST_MEMORY_MODE;
+
+typedef enum tagGALILEO_DEVICE_TYPE {
+	GALILEO_DEVICE_DEFAULT = 0, /* the default selector's choice, the device index is ignored */
+	GALILEO_DEVICE_ANY,
+	GALILEO_DEVICE_CPU,
+	GALILEO_DEVICE_GPU,
+	GALILEO_DEVICE_ACCELERATOR
+} GALILEO_DEVICE_TYPE;
+
+typedef enum tagGALILEO_OP {
+	GALILEO_OP_ABS = 0,
+	GALILEO_OP_ACOS,
+	GALILEO_OP_ACOSH,
+	GALILEO_OP_ASIN,
+	GALILEO_OP_ASINH,
+	GALILEO_OP_ATAN,
+	GALILEO_OP_ATANH,
+	GALILEO_OP_CONJ,
+	GALILEO_OP_COS,
+	GALILEO_OP_COSH,
+	GALILEO_OP_ERF,
+	GALILEO_OP_EXP,
+	GALILEO_OP_LOG,
+	GALILEO_OP_NEG,
+	GALILEO_OP_SIGN,
+	GALILEO_OP_SIN,
+	GALILEO_OP_SINH,
+	GALILEO_OP_SQRT,
+	GALILEO_OP_TAN,
+	GALILEO_OP_TANH,
+	GALILEO_OP_ADD,
+	GALILEO_OP_DIV,
+	GALILEO_OP_MUL,
+	GALILEO_OP_SUB
+} GALILEO_OP;
+
+typedef enum tagGALILEO_SCAN_MODE {
+	GALILEO_SCAN_INCLUSIVE = 0,
+	GALILEO_SCAN_EXCLUSIVE
+} GALILEO_SCAN_MODE;
+
+typedef enum tagGALILEO_ROUNDING_MODE {
+	GALILEO_ROUNDING_TRUNCATE = 0,
+	GALILEO_ROUNDING_NEAREST_EVEN,
+	GALILEO_ROUNDING_FLOOR,
+	GALILEO_ROUNDING_CEIL
+} GALILEO_ROUNDING_MODE;
+
+typedef enum tagGALILEO_SHARDING {
+	GALILEO_SHARDING_NUMA = 0, /* sub-devices of the default device, one per NUMA node */
+	GALILEO_SHARDING_DEVICES /* every device of the default device's platform */
+} GALILEO_SHARDING;
+
 typedef void* GALILEO_QUEUE;
+typedef void* GALILEO_EVENT;
+typedef void* GALILEO_EXPRESSION;
+typedef unsigned int GALILEO_EXPRESSION_NODE;
+typedef void* GALILEO_PLAN;
+typedef void* GALILEO_GRAPH;
+
+#define GALILEO_REDUCE_ALL_AXES (-1)
 
-#define GALILEO_MAX_TENSOR_DIMENSIONS 1
+#define GALILEO_MAX_TENSOR_DIMENSIONS 8
 typedef struct tagGALILEO_TENSOR_DIMENSIONS {
 	unsigned int tensor_dimensions[GALILEO_MAX_TENSOR_DIMENSIONS];
+	unsigned int tensor_strides[GALILEO_MAX_TENSOR_DIMENSIONS]; /* in elements, row-major order */
 	unsigned int tensor_dimensions_size;
 } GALILEO_TENSOR_DIMENSIONS;
 
+typedef struct tagGALILEO_POOL_STATISTICS {
+	unsigned long long reserved_bytes;
+	unsigned long long used_bytes;
+	unsigned long long cached_bytes;
+	unsigned long long allocations;
+	unsigned long long cache_hits;
+	unsigned long long device_allocations;
+} GALILEO_POOL_STATISTICS;
+
+typedef struct tagGALILEO_WARMUP_STATISTICS {
+	unsigned long long kernels; /* op and data type combinations built */
+	unsigned long long skipped; /* combinations the op or the device doesn't support */
+	double milliseconds; /* wall time spent in GALILEO_Warmup */
+} GALILEO_WARMUP_STATISTICS;
+
+/* zero-initialized properties give the queue of GALILEO_InitQueue */
+typedef struct tagGALILEO_QUEUE_PROPERTIES {
+	GALILEO_DEVICE_TYPE device_type;
+	unsigned int device_index; /* among the devices of device_type, as listed by GALILEO_EnumerateDevices */
+	int in_order;
+	int enable_profiling;
+	int discard_events; /* hint that the caller doesn't use the events of the submissions */
+} GALILEO_QUEUE_PROPERTIES;
+
+typedef struct tagGALILEO_DEVICE_INFO {
+	GALILEO_DEVICE_TYPE device_type;
+	unsigned int device_index;
+	char name[256];
+	char vendor[256];
+	unsigned int compute_units;
+	unsigned long long global_memory_bytes;
+} GALILEO_DEVICE_INFO;
+
+/* bucket n counts the calls that took [2^(n-1), 2^n) microseconds, the last bucket is open-ended */
+#define GALILEO_STATISTICS_HISTOGRAM_SIZE 16
+
+/* calls of one op with one data type (the first tensor's) on a profiled queue */
+typedef struct tagGALILEO_OP_STATISTICS {
+	char name[32];
+	GALILEO_DATA_TYPE data_type;
+	unsigned long long calls;
+	unsigned long long bytes; /* read and written by the calls, in total */
+	double validation_microseconds; /* host time spent checking the arguments */
+	double submit_microseconds; /* host time spent building and submitting the kernels */
+	double device_microseconds; /* zero unless the queue was created with profiling enabled */
+	unsigned long long host_histogram[GALILEO_STATISTICS_HISTOGRAM_SIZE];
+	unsigned long long device_histogram[GALILEO_STATISTICS_HISTOGRAM_SIZE];
+} GALILEO_OP_STATISTICS;
+
+/* zero-initialized properties pick 1M-element chunks and three chunks in flight */
+typedef struct tagGALILEO_STREAM_PROPERTIES {
+	unsigned int chunk_elements;
+	unsigned int queue_depth; /* chunks in flight, 2 double-buffers and 3 overlaps reading, computing and writing */
+} GALILEO_STREAM_PROPERTIES;
+
+/* masks of GALILEO_Warmup, bit n selects GALILEO_OP n or GALILEO_DATA_TYPE n */
+#define GALILEO_WARMUP_ALL_OPS (~0ull)
+#define GALILEO_WARMUP_ALL_TYPES (~0u)
+
+/* typed scalar operand, the member matching data_type is read (half values are passed as their bit pattern) */
+typedef struct tagGALILEO_SCALAR {
+	GALILEO_DATA_TYPE data_type;
+	union {
+		unsigned char uint8_value;
+		unsigned short uint16_value;
+		unsigned int uint32_value;
+		unsigned long long uint64_value;
+		signed char int8_value;
+		short int16_value;
+		int int32_value;
+		long long int64_value;
+		float float_value;
+		double double_value;
+		unsigned short half_bits;
+		float complex_float_value[2];
+		double complex_double_value[2];
+		unsigned short complex_half_bits[2];
+		unsigned short bfloat16_bits;
+	} value;
+} GALILEO_SCALAR;
+
 typedef struct tagGALILEO_TENSOR {
 	GALILEO_QUEUE associated_queue;
 	void* tensor_data;
 	GALILEO_DATA_TYPE data_type;
 	GALILEO_TENSOR_DIMENSIONS dimensions;
+	GALILEO_ALLOCATION_KIND allocation_kind;
+	const void* validated_data; /* set by the tensor constructors, validation is skipped while it matches tensor_data */
 } GALILEO_TENSOR;
 
 
@@ -51,10 +208,42 @@ extern "C" {
 GALILEO_RESULT GALILEO_GetLibVersion(unsigned int* major, unsigned int* minor, unsigned int* patch);
 GALILEO_RESULT GALILEO_GetQueueSize(unsigned int* size);
 GALILEO_RESULT GALILEO_InitQueue(GALILEO_QUEUE queue);
+GALILEO_RESULT GALILEO_InitQueueEx(GALILEO_QUEUE queue, const GALILEO_QUEUE_PROPERTIES* properties);
+GALILEO_RESULT GALILEO_EnumerateDevices(GALILEO_DEVICE_INFO* devices, unsigned int* count);
+// waits for the queue, memory allocated by the user and not deallocated stays valid after the release
 GALILEO_RESULT GALILEO_ReleaseQueue(GALILEO_QUEUE queue);
+GALILEO_RESULT GALILEO_InitShardedQueue(GALILEO_QUEUE queue, GALILEO_SHARDING sharding);
+GALILEO_RESULT GALILEO_GetShardCount(GALILEO_QUEUE queue, unsigned int* count);
 GALILEO_RESULT GALILEO_Allocate(GALILEO_QUEUE queue, GALILEO_DATA_TYPE data_type, unsigned int size, void** ptr);
+GALILEO_RESULT GALILEO_AllocateEx(GALILEO_QUEUE queue, GALILEO_DATA_TYPE data_type, unsigned int size, GALILEO_ALLOCATION_KIND allocation_kind, void** ptr);
 GALILEO_RESULT GALILEO_Deallocate(GALILEO_QUEUE queue, void* ptr);
+GALILEO_RESULT GALILEO_TrimPool(GALILEO_QUEUE queue);
+GALILEO_RESULT GALILEO_GetPoolStatistics(GALILEO_QUEUE queue, GALILEO_POOL_STATISTICS* statistics);
+GALILEO_RESULT GALILEO_SetHostThreshold(GALILEO_QUEUE queue, unsigned int elements);
+GALILEO_RESULT GALILEO_Warmup(GALILEO_QUEUE queue, unsigned long long op_mask, unsigned int type_mask);
+GALILEO_RESULT GALILEO_GetWarmupStatistics(GALILEO_QUEUE queue, GALILEO_WARMUP_STATISTICS* statistics);
+GALILEO_RESULT GALILEO_SetProfiling(GALILEO_QUEUE queue, int enable);
+GALILEO_RESULT GALILEO_GetStats(GALILEO_QUEUE queue, GALILEO_OP_STATISTICS* statistics, unsigned int* count);
+GALILEO_RESULT GALILEO_ResetStats(GALILEO_QUEUE queue);
+GALILEO_RESULT GALILEO_WriteTrace(GALILEO_QUEUE queue, const char* path);
+GALILEO_RESULT GALILEO_RegisterPointer(GALILEO_QUEUE queue, void* ptr, size_t size);
+GALILEO_RESULT GALILEO_UnregisterPointer(GALILEO_QUEUE queue, void* ptr);
+// a mirrored buffer is a snapshot taken at registration: host writes made afterwards aren't seen by the ops,
+// and their results only reach the host memory when GALILEO_UnregisterHostMemory copies the snapshot back
+// an imported buffer is shared with the device and has neither limitation, see GALILEO_HOST_MEMORY_MODE
+// the mode is read on input (a null one allows mirroring) and set to the one used, GALILEO_RESULT_NON_USM_POINTER means the buffer can't be imported
+GALILEO_RESULT GALILEO_RegisterHostMemory(GALILEO_QUEUE queue, void* ptr, size_t size, GALILEO_HOST_MEMORY_MODE* mode);
+GALILEO_RESULT GALILEO_UnregisterHostMemory(GALILEO_QUEUE queue, void* ptr);
 GALILEO_RESULT GALILEO_Create1dTensor(GALILEO_QUEUE queue, void* ptr, GALILEO_DATA_TYPE data_type, unsigned int size, GALILEO_TENSOR* tensor);
+GALILEO_RESULT GALILEO_CreateNdTensor(GALILEO_QUEUE queue, void* ptr, GALILEO_DATA_TYPE data_type, const unsigned int* dimensions, const unsigned int* strides, unsigned int dimensions_size, GALILEO_TENSOR* tensor);
+GALILEO_RESULT GALILEO_Memcpy(GALILEO_QUEUE queue, void* dst, const void* src, size_t size);
+GALILEO_RESULT GALILEO_MemcpyAsync(GALILEO_QUEUE queue, void* dst, const void* src, size_t size, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_Prefetch(const GALILEO_TENSOR* tensor);
+GALILEO_RESULT GALILEO_MemAdvise(const GALILEO_TENSOR* tensor, int advice);
+
+GALILEO_RESULT GALILEO_QueueWait(GALILEO_QUEUE queue);
+GALILEO_RESULT GALILEO_WaitEvents(const GALILEO_EVENT* events, unsigned int events_size);
+GALILEO_RESULT GALILEO_ReleaseEvent(GALILEO_EVENT event);
 
 GALILEO_RESULT GALILEO_Abs(const GALILEO_TENSOR* input, GALILEO_TENSOR* output);
 GALILEO_RESULT GALILEO_Acos(const GALILEO_TENSOR* input, GALILEO_TENSOR* output);
@@ -68,6 +257,7 @@ GALILEO_RESULT GALILEO_Cos(const GALILEO_TENSOR* input, GALILEO_TENSOR* output);
 GALILEO_RESULT GALILEO_Cosh(const GALILEO_TENSOR* input, GALILEO_TENSOR* output);
 GALILEO_RESULT GALILEO_Erf(const GALILEO_TENSOR* input, GALILEO_TENSOR* output);
 GALILEO_RESULT GALILEO_Exp(const GALILEO_TENSOR* input, GALILEO_TENSOR* output);
+GALILEO_RESULT GALILEO_Log(const GALILEO_TENSOR* input, GALILEO_TENSOR* output);
 GALILEO_RESULT GALILEO_Neg(const GALILEO_TENSOR* input, GALILEO_TENSOR* output);
 GALILEO_RESULT GALILEO_Sign(const GALILEO_TENSOR* input, GALILEO_TENSOR* output);
 GALILEO_RESULT GALILEO_Sin(const GALILEO_TENSOR* input, GALILEO_TENSOR* output);
@@ -81,6 +271,133 @@ GALILEO_RESULT GALILEO_Div(const GALILEO_TENSOR* input_lhs, const GALILEO_TENSOR
 GALILEO_RESULT GALILEO_Mul(const GALILEO_TENSOR* input_lhs, const GALILEO_TENSOR* input_rhs, GALILEO_TENSOR* output);
 GALILEO_RESULT GALILEO_Sub(const GALILEO_TENSOR* input_lhs, const GALILEO_TENSOR* input_rhs, GALILEO_TENSOR* output);
 
+// Asynchronous variants, the completion event (optional) must be released with GALILEO_ReleaseEvent
+GALILEO_RESULT GALILEO_AbsAsync(const GALILEO_TENSOR* input, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_AcosAsync(const GALILEO_TENSOR* input, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_AcoshAsync(const GALILEO_TENSOR* input, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_AsinAsync(const GALILEO_TENSOR* input, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_AsinhAsync(const GALILEO_TENSOR* input, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_AtanAsync(const GALILEO_TENSOR* input, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_AtanhAsync(const GALILEO_TENSOR* input, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_ConjAsync(const GALILEO_TENSOR* input, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_CosAsync(const GALILEO_TENSOR* input, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_CoshAsync(const GALILEO_TENSOR* input, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_ErfAsync(const GALILEO_TENSOR* input, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_ExpAsync(const GALILEO_TENSOR* input, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_LogAsync(const GALILEO_TENSOR* input, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_NegAsync(const GALILEO_TENSOR* input, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_SignAsync(const GALILEO_TENSOR* input, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_SinAsync(const GALILEO_TENSOR* input, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_SinhAsync(const GALILEO_TENSOR* input, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_SqrtAsync(const GALILEO_TENSOR* input, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_TanAsync(const GALILEO_TENSOR* input, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_TanhAsync(const GALILEO_TENSOR* input, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+
+GALILEO_RESULT GALILEO_AddAsync(const GALILEO_TENSOR* input_lhs, const GALILEO_TENSOR* input_rhs, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_DivAsync(const GALILEO_TENSOR* input_lhs, const GALILEO_TENSOR* input_rhs, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_MulAsync(const GALILEO_TENSOR* input_lhs, const GALILEO_TENSOR* input_rhs, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_SubAsync(const GALILEO_TENSOR* input_lhs, const GALILEO_TENSOR* input_rhs, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+
+// Ternary ops: Fma = a * b + c, Lerp = a + t * (b - a), Where = mask ? x : y with an unsigned integer mask
+// The output has the type of the widest operand, the others are promoted to it when no value is lost (e.g. int8 bounds of an int32 Clamp)
+GALILEO_RESULT GALILEO_Clamp(const GALILEO_TENSOR* input, const GALILEO_TENSOR* lower, const GALILEO_TENSOR* upper, GALILEO_TENSOR* output);
+GALILEO_RESULT GALILEO_Fma(const GALILEO_TENSOR* a, const GALILEO_TENSOR* b, const GALILEO_TENSOR* c, GALILEO_TENSOR* output);
+GALILEO_RESULT GALILEO_Lerp(const GALILEO_TENSOR* a, const GALILEO_TENSOR* b, const GALILEO_TENSOR* t, GALILEO_TENSOR* output);
+GALILEO_RESULT GALILEO_Where(const GALILEO_TENSOR* mask, const GALILEO_TENSOR* x, const GALILEO_TENSOR* y, GALILEO_TENSOR* output);
+
+GALILEO_RESULT GALILEO_ClampAsync(const GALILEO_TENSOR* input, const GALILEO_TENSOR* lower, const GALILEO_TENSOR* upper, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_FmaAsync(const GALILEO_TENSOR* a, const GALILEO_TENSOR* b, const GALILEO_TENSOR* c, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_LerpAsync(const GALILEO_TENSOR* a, const GALILEO_TENSOR* b, const GALILEO_TENSOR* t, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_WhereAsync(const GALILEO_TENSOR* mask, const GALILEO_TENSOR* x, const GALILEO_TENSOR* y, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+
+// Tensor-scalar ops, ScalarDiv/ScalarSub take the scalar as the left operand
+GALILEO_RESULT GALILEO_AddScalar(const GALILEO_TENSOR* input, const GALILEO_SCALAR* scalar, GALILEO_TENSOR* output);
+GALILEO_RESULT GALILEO_DivScalar(const GALILEO_TENSOR* input, const GALILEO_SCALAR* scalar, GALILEO_TENSOR* output);
+GALILEO_RESULT GALILEO_MulScalar(const GALILEO_TENSOR* input, const GALILEO_SCALAR* scalar, GALILEO_TENSOR* output);
+GALILEO_RESULT GALILEO_SubScalar(const GALILEO_TENSOR* input, const GALILEO_SCALAR* scalar, GALILEO_TENSOR* output);
+GALILEO_RESULT GALILEO_ScalarDiv(const GALILEO_TENSOR* input, const GALILEO_SCALAR* scalar, GALILEO_TENSOR* output);
+GALILEO_RESULT GALILEO_ScalarSub(const GALILEO_TENSOR* input, const GALILEO_SCALAR* scalar, GALILEO_TENSOR* output);
+GALILEO_RESULT GALILEO_Axpby(const GALILEO_SCALAR* alpha, const GALILEO_TENSOR* x, const GALILEO_SCALAR* beta, const GALILEO_TENSOR* y, GALILEO_TENSOR* output);
+
+GALILEO_RESULT GALILEO_AddScalarAsync(const GALILEO_TENSOR* input, const GALILEO_SCALAR* scalar, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_DivScalarAsync(const GALILEO_TENSOR* input, const GALILEO_SCALAR* scalar, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_MulScalarAsync(const GALILEO_TENSOR* input, const GALILEO_SCALAR* scalar, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_SubScalarAsync(const GALILEO_TENSOR* input, const GALILEO_SCALAR* scalar, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_ScalarDivAsync(const GALILEO_TENSOR* input, const GALILEO_SCALAR* scalar, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_ScalarSubAsync(const GALILEO_TENSOR* input, const GALILEO_SCALAR* scalar, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_AxpbyAsync(const GALILEO_SCALAR* alpha, const GALILEO_TENSOR* x, const GALILEO_SCALAR* beta, const GALILEO_TENSOR* y, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+
+// Conversions: Cast covers every pair of data types (complex to real keeps the real part), saturate clamps to the output range
+// Quantize/Dequantize map between floating point and GALILEO_INT8/GALILEO_UINT8 with a GALILEO_FLOAT scale and an optional GALILEO_INT32 zero point,
+// both holding a single element (per-tensor) or one element per channel of the axis
+GALILEO_RESULT GALILEO_Cast(const GALILEO_TENSOR* input, GALILEO_TENSOR* output, GALILEO_ROUNDING_MODE rounding, int saturate);
+GALILEO_RESULT GALILEO_Quantize(const GALILEO_TENSOR* input, const GALILEO_TENSOR* scale, const GALILEO_TENSOR* zero_point, int axis, GALILEO_TENSOR* output);
+GALILEO_RESULT GALILEO_Dequantize(const GALILEO_TENSOR* input, const GALILEO_TENSOR* scale, const GALILEO_TENSOR* zero_point, int axis, GALILEO_TENSOR* output);
+
+GALILEO_RESULT GALILEO_CastAsync(const GALILEO_TENSOR* input, GALILEO_TENSOR* output, GALILEO_ROUNDING_MODE rounding, int saturate, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_QuantizeAsync(const GALILEO_TENSOR* input, const GALILEO_TENSOR* scale, const GALILEO_TENSOR* zero_point, int axis, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_DequantizeAsync(const GALILEO_TENSOR* input, const GALILEO_TENSOR* scale, const GALILEO_TENSOR* zero_point, int axis, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+
+// Reductions over the whole tensor (GALILEO_REDUCE_ALL_AXES) or along a single axis, ArgMin/ArgMax produce GALILEO_INT64 indices
+GALILEO_RESULT GALILEO_Sum(const GALILEO_TENSOR* input, int axis, GALILEO_TENSOR* output);
+GALILEO_RESULT GALILEO_Prod(const GALILEO_TENSOR* input, int axis, GALILEO_TENSOR* output);
+GALILEO_RESULT GALILEO_Min(const GALILEO_TENSOR* input, int axis, GALILEO_TENSOR* output);
+GALILEO_RESULT GALILEO_Max(const GALILEO_TENSOR* input, int axis, GALILEO_TENSOR* output);
+GALILEO_RESULT GALILEO_Mean(const GALILEO_TENSOR* input, int axis, GALILEO_TENSOR* output);
+GALILEO_RESULT GALILEO_Norm(const GALILEO_TENSOR* input, int axis, GALILEO_TENSOR* output);
+GALILEO_RESULT GALILEO_ArgMin(const GALILEO_TENSOR* input, int axis, GALILEO_TENSOR* output);
+GALILEO_RESULT GALILEO_ArgMax(const GALILEO_TENSOR* input, int axis, GALILEO_TENSOR* output);
+
+GALILEO_RESULT GALILEO_SumAsync(const GALILEO_TENSOR* input, int axis, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_ProdAsync(const GALILEO_TENSOR* input, int axis, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_MinAsync(const GALILEO_TENSOR* input, int axis, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_MaxAsync(const GALILEO_TENSOR* input, int axis, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_MeanAsync(const GALILEO_TENSOR* input, int axis, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_NormAsync(const GALILEO_TENSOR* input, int axis, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_ArgMinAsync(const GALILEO_TENSOR* input, int axis, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_ArgMaxAsync(const GALILEO_TENSOR* input, int axis, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+
+// Prefix sums and stream compaction in the row-major element order, Compact writes the number of selected elements to a GALILEO_INT64 count tensor
+GALILEO_RESULT GALILEO_CumSum(const GALILEO_TENSOR* input, GALILEO_SCAN_MODE mode, GALILEO_TENSOR* output);
+GALILEO_RESULT GALILEO_CumSumAsync(const GALILEO_TENSOR* input, GALILEO_SCAN_MODE mode, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_Compact(const GALILEO_TENSOR* input, const GALILEO_TENSOR* mask, GALILEO_TENSOR* output, GALILEO_TENSOR* count);
+GALILEO_RESULT GALILEO_CompactAsync(const GALILEO_TENSOR* input, const GALILEO_TENSOR* mask, GALILEO_TENSOR* output, GALILEO_TENSOR* count, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+
+// Deferred elementwise expressions: every connected subgraph is evaluated with a single fused kernel
+GALILEO_RESULT GALILEO_CreateExpression(GALILEO_QUEUE queue, GALILEO_EXPRESSION* expression);
+GALILEO_RESULT GALILEO_ReleaseExpression(GALILEO_EXPRESSION expression);
+GALILEO_RESULT GALILEO_ExpressionInput(GALILEO_EXPRESSION expression, const GALILEO_TENSOR* input, GALILEO_EXPRESSION_NODE* node);
+GALILEO_RESULT GALILEO_ExpressionUnary(GALILEO_EXPRESSION expression, GALILEO_OP op, GALILEO_EXPRESSION_NODE input, GALILEO_EXPRESSION_NODE* node);
+GALILEO_RESULT GALILEO_ExpressionBinary(GALILEO_EXPRESSION expression, GALILEO_OP op, GALILEO_EXPRESSION_NODE input_lhs, GALILEO_EXPRESSION_NODE input_rhs, GALILEO_EXPRESSION_NODE* node);
+GALILEO_RESULT GALILEO_ExpressionOutput(GALILEO_EXPRESSION expression, GALILEO_EXPRESSION_NODE node, GALILEO_TENSOR* output);
+GALILEO_RESULT GALILEO_ExpressionEvaluate(GALILEO_EXPRESSION expression);
+GALILEO_RESULT GALILEO_ExpressionEvaluateAsync(GALILEO_EXPRESSION expression, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_StreamExpression(GALILEO_EXPRESSION expression, const char* const* input_paths, const char* const* output_paths, const GALILEO_STREAM_PROPERTIES* properties);
+
+// Prebound plans: the op is validated and its typed kernel resolved once, the tensors (data pointers and shapes) are captured at creation
+// inputs holds one tensor for the unary ops and two for the binary ones
+GALILEO_RESULT GALILEO_CreatePlan(GALILEO_OP op, const GALILEO_TENSOR* const* inputs, unsigned int inputs_size, GALILEO_TENSOR* output, GALILEO_PLAN* plan);
+GALILEO_RESULT GALILEO_ExecutePlan(GALILEO_PLAN plan);
+GALILEO_RESULT GALILEO_ExecutePlanAsync(GALILEO_PLAN plan, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_DestroyPlan(GALILEO_PLAN plan);
+
+// Multi-tensor launches: one op over count independent tensor sets (input, or lhs and rhs, and output) in a single kernel
+// the sets share the data types, every set is contiguous and its tensors have the same shape
+GALILEO_RESULT GALILEO_UnaryMulti(GALILEO_OP op, const GALILEO_TENSOR* inputs, GALILEO_TENSOR* outputs, unsigned int count);
+GALILEO_RESULT GALILEO_UnaryMultiAsync(GALILEO_OP op, const GALILEO_TENSOR* inputs, GALILEO_TENSOR* outputs, unsigned int count, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_BinaryMulti(GALILEO_OP op, const GALILEO_TENSOR* inputs_lhs, const GALILEO_TENSOR* inputs_rhs, GALILEO_TENSOR* outputs, unsigned int count);
+GALILEO_RESULT GALILEO_BinaryMultiAsync(GALILEO_OP op, const GALILEO_TENSOR* inputs_lhs, const GALILEO_TENSOR* inputs_rhs, GALILEO_TENSOR* outputs, unsigned int count, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+
+// Captured graphs: the ops submitted to the queue between BeginCapture and EndCapture are recorded instead of being run,
+// GraphLaunch runs the whole sequence in the recorded order. The data pointers of the recorded op tensors may be replaced between launches
+// A graph can't be launched while its queue is captured
+GALILEO_RESULT GALILEO_BeginCapture(GALILEO_QUEUE queue);
+GALILEO_RESULT GALILEO_EndCapture(GALILEO_QUEUE queue, GALILEO_GRAPH* graph);
+GALILEO_RESULT GALILEO_GraphLaunch(GALILEO_GRAPH graph);
+GALILEO_RESULT GALILEO_GraphLaunchAsync(GALILEO_GRAPH graph, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event);
+GALILEO_RESULT GALILEO_GraphUpdatePointer(GALILEO_GRAPH graph, const void* old_ptr, void* new_ptr);
+GALILEO_RESULT GALILEO_ReleaseGraph(GALILEO_GRAPH graph);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,94 @@
+#include "common.hpp"
+#include "context.hpp"
+#include "graph.hpp"
+
+GALILEO_RESULT GALILEO_BeginCapture(GALILEO_QUEUE queue) {
+	try {
+		if (!queue)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		auto& context = galileo::common::GetQueueContext(queue);
+		if (context.capture)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+		context.capture = std::make_unique<std::vector<galileo::common::RecordedOp>>();
+	}
+	catch (GALILEO_RESULT res) {
+		return res;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+	return GALILEO_RESULT::GALILEO_RESULT_OK;
+}
+
+GALILEO_RESULT GALILEO_EndCapture(GALILEO_QUEUE queue, GALILEO_GRAPH* graph) {
+	try {
+		if (!queue || !graph)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		auto& context = galileo::common::GetQueueContext(queue);
+		if (!context.capture)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+		auto ops = std::move(*context.capture);
+		context.capture.reset();
+		*graph = new galileo::Graph(queue, std::move(ops));
+	}
+	catch (GALILEO_RESULT res) {
+		return res;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+	return GALILEO_RESULT::GALILEO_RESULT_OK;
+}
+
+GALILEO_RESULT GALILEO_GraphLaunchAsync(GALILEO_GRAPH graph, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event) {
+	try {
+		const auto profile_start = galileo::common::ProfileClock::now();
+		if (!graph)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		auto& typed_graph = galileo::GetGraph(graph);
+		auto dependencies = galileo::common::GetEvents(wait_events, wait_events_size);
+		galileo::common::SetEvent(event, galileo::common::ProfileOp(typed_graph.GetQueue(), "Graph", profile_start, typed_graph.GetTensors(), [&](const auto&) { return typed_graph.Launch(dependencies); }));
+	}
+	catch (GALILEO_RESULT res) {
+		return res;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+	return GALILEO_RESULT::GALILEO_RESULT_OK;
+}
+
+GALILEO_RESULT GALILEO_GraphLaunch(GALILEO_GRAPH graph) {
+	return GALILEO_GraphLaunchAsync(graph, nullptr, 0, nullptr);
+}
+
+GALILEO_RESULT GALILEO_GraphUpdatePointer(GALILEO_GRAPH graph, const void* old_ptr, void* new_ptr) {
+	try {
+		if (!graph || !old_ptr || !new_ptr)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		auto& typed_graph = galileo::GetGraph(graph);
+		if (!galileo::common::VerifyPtr(typed_graph.GetQueue(), new_ptr))
+			return GALILEO_RESULT::GALILEO_RESULT_NON_USM_POINTER;
+		if (!typed_graph.UpdatePointer(old_ptr, new_ptr))
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+	}
+	catch (GALILEO_RESULT res) {
+		return res;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+	return GALILEO_RESULT::GALILEO_RESULT_OK;
+}
+
+GALILEO_RESULT GALILEO_ReleaseGraph(GALILEO_GRAPH graph) {
+	if (!graph)
+		return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+	delete &galileo::GetGraph(graph);
+	return GALILEO_RESULT::GALILEO_RESULT_OK;
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "common.hpp"
+#include "context.hpp"
+
+#include <optional>
+#include <vector>
+
+#ifdef SYCL_EXT_ONEAPI_GRAPH
+#include <sycl/ext/oneapi/experimental/graph.hpp>
+#endif
+
+namespace galileo {
+	inline namespace detail {
+		// ops captured on a queue, replayed in the recorded order, each one waiting for the previous
+		class Graph {
+			GALILEO_QUEUE queue;
+			std::vector<common::RecordedOp> ops;
+#ifdef SYCL_EXT_ONEAPI_GRAPH
+			using executable_graph = sycl::ext::oneapi::experimental::command_graph<sycl::ext::oneapi::experimental::graph_state::executable>;
+			// rebuilt on the first launch after a pointer update, host replay is used when the device can't run it
+			std::optional<executable_graph> executable;
+			std::vector<void*> scratch;
+			bool is_graph_supported = true;
+
+			void ReleaseScratch() {
+				auto& pool = common::GetQueueContext(queue).pool;
+				for (auto ptr : scratch)
+					pool.Deallocate(ptr);
+				scratch.clear();
+			}
+
+			void Build() {
+				namespace experimental = sycl::ext::oneapi::experimental;
+				auto& typed_queue = common::GetQueue(queue);
+				auto& context = common::GetQueueContext(queue);
+				ReleaseScratch();
+				try {
+					experimental::command_graph graph(typed_queue.get_context(), typed_queue.get_device());
+					context.recording_scratch = &scratch;
+					graph.begin_recording(typed_queue);
+					try {
+						Replay({});
+					}
+					catch (...) {
+						graph.end_recording(typed_queue);
+						throw;
+					}
+					graph.end_recording(typed_queue);
+					context.recording_scratch = nullptr;
+					executable.emplace(graph.finalize());
+				}
+				catch (const sycl::exception&) {
+					context.recording_scratch = nullptr;
+					ReleaseScratch();
+					is_graph_supported = false;
+				}
+				catch (...) {
+					context.recording_scratch = nullptr;
+					throw;
+				}
+			}
+#endif
+
+			sycl::event Replay(const std::vector<sycl::event>& dependencies) {
+				auto event_dependencies = dependencies;
+				sycl::event event;
+				for (auto& op : ops) {
+					event = op.submit(queue, op.tensors.data(), event_dependencies);
+					event_dependencies = { event };
+				}
+				return event;
+			}
+
+		public:
+			Graph(GALILEO_QUEUE queue, std::vector<common::RecordedOp> ops) : queue(queue), ops(std::move(ops)) {}
+
+			~Graph() {
+#ifdef SYCL_EXT_ONEAPI_GRAPH
+				ReleaseScratch();
+#endif
+			}
+
+			Graph(const Graph&) = delete;
+			Graph& operator=(const Graph&) = delete;
+
+			// a graph isn't captured into another one, the outer graph would outlive the commands and the scratch of this one
+			sycl::event Launch(const std::vector<sycl::event>& dependencies) {
+				if (common::GetQueueContext(queue).capture)
+					throw GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+#ifdef SYCL_EXT_ONEAPI_GRAPH
+				if (is_graph_supported && !executable)
+					Build();
+				if (executable) {
+					auto launch = [this](sycl::handler& h) { h.ext_oneapi_graph(*executable); };
+					return common::Submit(queue, launch, dependencies);
+				}
+#endif
+				return Replay(dependencies);
+			}
+
+			// retargets every recorded tensor with the old data pointer, returns the number of updated tensors
+			unsigned int UpdatePointer(const void* old_ptr, void* new_ptr) {
+				unsigned int updated = 0;
+				for (auto& op : ops) {
+					for (auto& tensor : op.tensors) {
+						if (tensor.tensor_data != old_ptr)
+							continue;
+						tensor.tensor_data = new_ptr;
+						tensor.validated_data = new_ptr;
+						++updated;
+					}
+				}
+#ifdef SYCL_EXT_ONEAPI_GRAPH
+				if (updated)
+					executable.reset();
+#endif
+				return updated;
+			}
+
+			GALILEO_QUEUE GetQueue() const {
+				return queue;
+			}
+
+			// tensors of every recorded op, in the recorded order
+			std::vector<GALILEO_TENSOR> GetTensors() const {
+				std::vector<GALILEO_TENSOR> tensors;
+				for (const auto& op : ops)
+					tensors.insert(tensors.end(), op.tensors.begin(), op.tensors.end());
+				return tensors;
+			}
+		};
+
+		inline auto& GetGraph(GALILEO_GRAPH graph) {
+			return *reinterpret_cast<Graph*>(graph);
+		}
+	}
+}
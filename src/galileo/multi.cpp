@@ -0,0 +1,108 @@
+#include "common.hpp"
+#include "context.hpp"
+#include "fusion.hpp"
+#include "multi.hpp"
+
+#include <vector>
+
+#define MULTI_UNARY_OP_CASE(NAME, OP) case GALILEO_OP_ ## OP: return galileo::common::ProfileOp(queue, #NAME "Multi", profile_start, tensors, [&](const auto& op_tensors) { return galileo::common::SubmitOp(queue, op_tensors, [count](GALILEO_TENSOR* multi_tensors) { return galileo::MultiElementwiseOp<NAME, 1>(multi_tensors, count); }, dependencies); });
+#define MULTI_BINARY_OP_CASE(NAME, OP) case GALILEO_OP_ ## OP: return galileo::common::ProfileOp(queue, #NAME "Multi", profile_start, tensors, [&](const auto& op_tensors) { return galileo::common::SubmitOp(queue, op_tensors, [count](GALILEO_TENSOR* multi_tensors) { return galileo::MultiElementwiseOp<NAME, 2>(multi_tensors, count); }, dependencies); });
+
+namespace {
+	// every set of tensors is checked as the single-tensor op would, the sets additionally have to be contiguous and unbroadcast
+	GALILEO_RESULT VerifyMultiTensors(std::initializer_list<const GALILEO_TENSOR*> operands, unsigned int count) {
+		const auto queue = (*operands.begin())[0].associated_queue;
+		for (unsigned int i = 0; i < count; ++i) {
+			const auto& output = operands.end()[-1][i];
+			for (const auto* operand : operands) {
+				const auto& tensor = operand[i];
+				if (!tensor.tensor_data)
+					return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+				if (tensor.associated_queue != queue)
+					return GALILEO_RESULT::GALILEO_RESULT_TENSOR_QUEUE_MISMATCH;
+				if (!galileo::common::VerifyDimensionsPtrs(tensor, output) || !galileo::common::IsContiguous(tensor.dimensions))
+					return GALILEO_RESULT::GALILEO_RESULT_TENSOR_DIMENSIONS_MISMATCH;
+				if (!galileo::common::VerifyTensor(tensor))
+					return GALILEO_RESULT_NON_USM_POINTER;
+			}
+		}
+		return GALILEO_RESULT::GALILEO_RESULT_OK;
+	}
+
+	template <std::size_t operands_size>
+	std::vector<GALILEO_TENSOR> GetMultiTensors(const std::array<const GALILEO_TENSOR*, operands_size>& operands, unsigned int count) {
+		std::vector<GALILEO_TENSOR> tensors;
+		tensors.reserve(operands_size * count);
+		for (const auto* operand : operands)
+			tensors.insert(tensors.end(), operand, operand + count);
+		return tensors;
+	}
+
+	sycl::event SubmitUnaryMulti(GALILEO_OP op, GALILEO_QUEUE queue, galileo::common::ProfileClock::time_point profile_start, const std::vector<GALILEO_TENSOR>& tensors, unsigned int count, const std::vector<sycl::event>& dependencies) {
+		switch (op) {
+		GALILEO_UNARY_OPS(MULTI_UNARY_OP_CASE)
+		default:
+			throw GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+		}
+	}
+
+	sycl::event SubmitBinaryMulti(GALILEO_OP op, GALILEO_QUEUE queue, galileo::common::ProfileClock::time_point profile_start, const std::vector<GALILEO_TENSOR>& tensors, unsigned int count, const std::vector<sycl::event>& dependencies) {
+		switch (op) {
+		GALILEO_BINARY_OPS(MULTI_BINARY_OP_CASE)
+		default:
+			throw GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+		}
+	}
+}
+
+GALILEO_RESULT GALILEO_UnaryMultiAsync(GALILEO_OP op, const GALILEO_TENSOR* inputs, GALILEO_TENSOR* outputs, unsigned int count, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event) {
+	try {
+		const auto profile_start = galileo::common::ProfileClock::now();
+		if (!inputs || !outputs || !count || !galileo::IsUnaryOp(op))
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		if (auto result = VerifyMultiTensors({ inputs, outputs }, count); result != GALILEO_RESULT::GALILEO_RESULT_OK)
+			return result;
+
+		auto dependencies = galileo::common::GetEvents(wait_events, wait_events_size);
+		auto tensors = GetMultiTensors<2>({ inputs, outputs }, count);
+		galileo::common::SetEvent(event, SubmitUnaryMulti(op, inputs->associated_queue, profile_start, tensors, count, dependencies));
+	}
+	catch (GALILEO_RESULT res) {
+		return res;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+	return GALILEO_RESULT::GALILEO_RESULT_OK;
+}
+
+GALILEO_RESULT GALILEO_UnaryMulti(GALILEO_OP op, const GALILEO_TENSOR* inputs, GALILEO_TENSOR* outputs, unsigned int count) {
+	return GALILEO_UnaryMultiAsync(op, inputs, outputs, count, nullptr, 0, nullptr);
+}
+
+GALILEO_RESULT GALILEO_BinaryMultiAsync(GALILEO_OP op, const GALILEO_TENSOR* inputs_lhs, const GALILEO_TENSOR* inputs_rhs, GALILEO_TENSOR* outputs, unsigned int count, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event) {
+	try {
+		const auto profile_start = galileo::common::ProfileClock::now();
+		if (!inputs_lhs || !inputs_rhs || !outputs || !count || !galileo::IsBinaryOp(op))
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		if (auto result = VerifyMultiTensors({ inputs_lhs, inputs_rhs, outputs }, count); result != GALILEO_RESULT::GALILEO_RESULT_OK)
+			return result;
+
+		auto dependencies = galileo::common::GetEvents(wait_events, wait_events_size);
+		auto tensors = GetMultiTensors<3>({ inputs_lhs, inputs_rhs, outputs }, count);
+		galileo::common::SetEvent(event, SubmitBinaryMulti(op, inputs_lhs->associated_queue, profile_start, tensors, count, dependencies));
+	}
+	catch (GALILEO_RESULT res) {
+		return res;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+	return GALILEO_RESULT::GALILEO_RESULT_OK;
+}
+
+GALILEO_RESULT GALILEO_BinaryMulti(GALILEO_OP op, const GALILEO_TENSOR* inputs_lhs, const GALILEO_TENSOR* inputs_rhs, GALILEO_TENSOR* outputs, unsigned int count) {
+	return GALILEO_BinaryMultiAsync(op, inputs_lhs, inputs_rhs, outputs, count, nullptr, 0, nullptr);
+}
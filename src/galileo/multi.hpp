@@ -0,0 +1,122 @@
+#pragma once
+
+#include "common.hpp"
+#include "context.hpp"
+#include "unary.hpp"
+#include "binary.hpp"
+
+#include <array>
+#include <cstring>
+#include <variant>
+#include <vector>
+
+namespace galileo {
+	inline namespace detail {
+		// one launch of an elementwise op over many independent tensors of the same data types
+		// tensors holds count tensors per operand, inputs first and the outputs last
+		template <typename Kernel, std::size_t inputs_size>
+		struct MultiElementwiseOp {
+		protected:
+			struct Descriptor {
+				std::array<const void*, inputs_size> inputs;
+				void* output;
+				// exclusive prefix sum of the tensor sizes
+				std::size_t offset;
+			};
+
+			// the kernel of the single-tensor op decides which combinations GALILEO_TYPES and GALILEO_OPS leave in the build
+			template <typename D, typename ... T>
+			static constexpr bool is_supported = [] {
+				if constexpr (inputs_size == 1)
+					return (Kernel::template is_supported_type<T> && ...) && Kernel::template is_supported_type<D>;
+				else
+					return Kernel::template is_supported_pair<T...>;
+			}();
+
+			template <typename D, typename ... T>
+			void Process(sycl::handler& h, const Descriptor* table) {
+				if constexpr (!is_supported<D, T...>)
+					throw GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE;
+				else {
+					const std::size_t tensors_size = descriptors.size();
+					h.parallel_for(size, [=](sycl::id<1> i) {
+						// the last tensor starting at or before the element, empty tensors share the offset of the next one
+						std::size_t first = 0;
+						std::size_t last = tensors_size;
+						while (last - first > 1) {
+							const auto middle = (first + last) / 2;
+							if (table[middle].offset <= i[0])
+								first = middle;
+							else
+								last = middle;
+						}
+						const auto& descriptor = table[first];
+						const auto index = i[0] - descriptor.offset;
+						auto output_ptr = static_cast<D*>(descriptor.output);
+						if constexpr (inputs_size == 1)
+							output_ptr[index] = Kernel::template Apply<T..., D>(static_cast<const T*>(descriptor.inputs[0])[index]...);
+						else {
+							auto apply = [&]<std::size_t ... operands>(std::index_sequence<operands...>) {
+								return Kernel::template Apply<T...>(static_cast<const T*>(descriptor.inputs[operands])[index]...);
+							};
+							output_ptr[index] = apply(std::index_sequence_for<T...>{});
+						}
+						});
+				}
+			}
+
+		public:
+			Kernel kernel;
+			std::vector<Descriptor> descriptors;
+			std::size_t size = 0;
+
+			// the first set of tensors picks the typed kernel, the others have to match its data types
+			MultiElementwiseOp(GALILEO_TENSOR* tensors, std::size_t count) : kernel(MakeKernel(tensors, count, std::make_index_sequence<inputs_size>{})) {
+				descriptors.reserve(count);
+				for (std::size_t i = 0; i < count; ++i) {
+					Descriptor descriptor{};
+					for (std::size_t operand = 0; operand <= inputs_size; ++operand) {
+						const auto& tensor = tensors[operand * count + i];
+						if (tensor.data_type != tensors[operand * count].data_type)
+							throw GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE;
+						if (operand < inputs_size)
+							descriptor.inputs[operand] = tensor.tensor_data;
+					}
+					descriptor.output = tensors[inputs_size * count + i].tensor_data;
+					descriptor.offset = size;
+					descriptors.push_back(descriptor);
+					size += common::GetTotalSize(tensors[inputs_size * count + i].dimensions);
+				}
+			}
+
+			// the descriptors are staged in host memory and copied to the device table ahead of the kernel
+			sycl::event Submit(GALILEO_QUEUE queue, const std::vector<sycl::event>& dependencies) {
+				auto& pool = common::GetQueueContext(queue).pool;
+				const auto table_size = descriptors.size() * sizeof(Descriptor);
+				auto staging = pool.Allocate(table_size, GALILEO_ALLOCATION_HOST);
+				std::memcpy(staging, descriptors.data(), table_size);
+				auto table = static_cast<Descriptor*>(pool.Allocate(table_size, GALILEO_ALLOCATION_DEVICE));
+
+				auto copy = [=](sycl::handler& h) { h.memcpy(table, staging, table_size); };
+				auto event = common::Submit(queue, copy, dependencies);
+				auto launch = [&](sycl::handler& h) {
+					// the binary output type follows from the input types
+					if constexpr (inputs_size == 1)
+						std::visit([&]<typename D, typename T>(D*, const T*) { Process<D, T>(h, table); }, kernel.output, kernel.input);
+					else
+						std::visit([&]<typename T, typename U>(const T*, const U*) { Process<typename Kernel::template output_t<T, U>, T, U>(h, table); }, kernel.input_lhs, kernel.input_rhs);
+				};
+				event = common::Submit(queue, launch, { event });
+				common::ReleaseScratch(queue, staging);
+				common::ReleaseScratch(queue, table);
+				return event;
+			}
+
+		private:
+			template <std::size_t ... operands>
+			static Kernel MakeKernel(GALILEO_TENSOR* tensors, std::size_t count, std::index_sequence<operands...>) {
+				return Kernel(tensors[operands * count]..., tensors[inputs_size * count]);
+			}
+		};
+	}
+}
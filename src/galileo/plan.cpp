@@ -0,0 +1,75 @@
+#include "common.hpp"
+#include "context.hpp"
+#include "fusion.hpp"
+#include "plan.hpp"
+
+#define PLAN_UNARY_OP_CASE(NAME, OP) case GALILEO_OP_ ## OP: *plan = galileo::CreateUnaryPlan<NAME>(*inputs[0], *output); break;
+#define PLAN_BINARY_OP_CASE(NAME, OP) case GALILEO_OP_ ## OP: *plan = galileo::CreateBinaryPlan<NAME>(*inputs[0], *inputs[1], *output); break;
+
+GALILEO_RESULT GALILEO_CreatePlan(GALILEO_OP op, const GALILEO_TENSOR* const* inputs, unsigned int inputs_size, GALILEO_TENSOR* output, GALILEO_PLAN* plan) {
+	try {
+		const auto is_unary = galileo::IsUnaryOp(op);
+		if (!plan || !inputs || !output || !output->tensor_data || inputs_size != (is_unary ? 1u : 2u) || (!is_unary && !galileo::IsBinaryOp(op)))
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+		for (unsigned int i = 0; i < inputs_size; ++i)
+			if (!inputs[i] || !inputs[i]->tensor_data)
+				return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		const auto& input_lhs = *inputs[0];
+		const auto& input_rhs = *inputs[inputs_size - 1];
+		if (!galileo::common::VerifyQueryPtrs(input_lhs, input_rhs, *output))
+			return GALILEO_RESULT::GALILEO_RESULT_TENSOR_QUEUE_MISMATCH;
+
+		const auto is_same_shape = is_unary ? galileo::common::VerifyDimensionsPtrs(input_lhs, *output) : galileo::common::VerifyBroadcastDimensions(input_lhs, input_rhs, *output);
+		if (!is_same_shape || !galileo::common::IsWritable(output->dimensions))
+			return GALILEO_RESULT::GALILEO_RESULT_TENSOR_DIMENSIONS_MISMATCH;
+
+		if (!galileo::common::VerifyTensor(input_lhs) || !galileo::common::VerifyTensor(input_rhs) || !galileo::common::VerifyTensor(*output))
+			return GALILEO_RESULT_NON_USM_POINTER;
+
+		switch (op) {
+		GALILEO_UNARY_OPS(PLAN_UNARY_OP_CASE)
+		GALILEO_BINARY_OPS(PLAN_BINARY_OP_CASE)
+		default:
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+		}
+	}
+	catch (GALILEO_RESULT res) {
+		return res;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+	return GALILEO_RESULT::GALILEO_RESULT_OK;
+}
+
+GALILEO_RESULT GALILEO_ExecutePlanAsync(GALILEO_PLAN plan, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event) {
+	try {
+		const auto profile_start = galileo::common::ProfileClock::now();
+		if (!plan)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		const auto& typed_plan = galileo::GetPlan(plan);
+		auto dependencies = galileo::common::GetEvents(wait_events, wait_events_size);
+		galileo::common::SetEvent(event, galileo::common::ProfileOp(typed_plan.queue, "Plan", profile_start, typed_plan.tensors, [&](const auto&) { return typed_plan.Execute(dependencies); }));
+	}
+	catch (GALILEO_RESULT res) {
+		return res;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+	return GALILEO_RESULT::GALILEO_RESULT_OK;
+}
+
+GALILEO_RESULT GALILEO_ExecutePlan(GALILEO_PLAN plan) {
+	return GALILEO_ExecutePlanAsync(plan, nullptr, 0, nullptr);
+}
+
+GALILEO_RESULT GALILEO_DestroyPlan(GALILEO_PLAN plan) {
+	if (!plan)
+		return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+	delete &galileo::GetPlan(plan);
+	return GALILEO_RESULT::GALILEO_RESULT_OK;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "common.hpp"
+#include "context.hpp"
+#include "unary.hpp"
+#include "binary.hpp"
+
+#include <array>
+#include <memory>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace galileo {
+	inline namespace detail {
+		using PlanLaunch = void(*)(void* kernel, sycl::handler& h);
+
+		template <typename Kernel, typename ... Types>
+		void LaunchTyped(void* kernel, sycl::handler& h) {
+			static_cast<Kernel*>(kernel)->template Launch<Types...>(h);
+		}
+
+		// one typed launch function per combination of the operand alternatives, flattened in the row-major order of the variant indices
+		template <typename Kernel, typename ... Variants>
+		struct PlanDispatchTable {
+			static constexpr std::size_t operands_size = sizeof...(Variants);
+			static constexpr std::array<std::size_t, operands_size> sizes = { std::variant_size_v<Variants>... };
+
+			template <std::size_t flat, std::size_t operand>
+			static constexpr std::size_t GetIndex() {
+				std::size_t stride = 1;
+				for (auto i = operand + 1; i < operands_size; ++i)
+					stride *= sizes[i];
+				return flat / stride % sizes[operand];
+			}
+
+			template <std::size_t flat, std::size_t ... operands>
+			static constexpr PlanLaunch GetEntry(std::index_sequence<operands...>) {
+				return &LaunchTyped<Kernel, std::remove_const_t<std::remove_pointer_t<std::variant_alternative_t<GetIndex<flat, operands>(), Variants>>>...>;
+			}
+
+			template <std::size_t ... flat>
+			static constexpr auto MakeTable(std::index_sequence<flat...>) {
+				return std::array<PlanLaunch, sizeof...(flat)>{ GetEntry<flat>(std::index_sequence_for<Variants...>{})... };
+			}
+
+			static constexpr auto table = MakeTable(std::make_index_sequence<(std::variant_size_v<Variants> * ...)>{});
+
+			static PlanLaunch Get(const Variants& ...variants) {
+				std::size_t flat = 0;
+				((flat = flat * std::variant_size_v<Variants> + variants.index()), ...);
+				return table[flat];
+			}
+		};
+
+		// validated op bound to its tensors, the data pointers and shapes are captured at creation
+		struct Plan {
+			GALILEO_QUEUE queue;
+			std::shared_ptr<void> kernel;
+			PlanLaunch launch;
+			// the bound tensors, the output last, as the profiler reports them
+			std::vector<GALILEO_TENSOR> tensors;
+
+			sycl::event Execute(const std::vector<sycl::event>& dependencies) const {
+				// a captured graph keeps the bound op alive on its own, the plan may be released before the graph runs
+				auto submit = [kernel = kernel, launch = launch](sycl::handler& h) { launch(kernel.get(), h); };
+				return common::Submit(queue, submit, dependencies);
+			}
+		};
+
+		template <typename Kernel>
+		Plan* CreateUnaryPlan(const GALILEO_TENSOR& input, GALILEO_TENSOR& output) {
+			auto kernel = std::make_shared<Kernel>(input, output);
+			auto launch = PlanDispatchTable<Kernel, typename Kernel::InputType, typename Kernel::OutputType>::Get(kernel->input, kernel->output);
+			return new Plan{ input.associated_queue, std::move(kernel), launch, { input, output } };
+		}
+
+		template <typename Kernel>
+		Plan* CreateBinaryPlan(const GALILEO_TENSOR& input_lhs, const GALILEO_TENSOR& input_rhs, GALILEO_TENSOR& output) {
+			auto kernel = std::make_shared<Kernel>(input_lhs, input_rhs, output);
+			auto launch = PlanDispatchTable<Kernel, typename Kernel::InputType, typename Kernel::InputType>::Get(kernel->input_lhs, kernel->input_rhs);
+			return new Plan{ input_lhs.associated_queue, std::move(kernel), launch, { input_lhs, input_rhs, output } };
+		}
+
+		inline auto& GetPlan(GALILEO_PLAN plan) {
+			return *reinterpret_cast<Plan*>(plan);
+		}
+	}
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "common.hpp"
+
+#include <bit>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+
+namespace galileo::common {
+	// events of the submitted commands in submission order, used to tell when memory released at some point is idle
+	class SubmissionTracker {
+		std::mutex mutex;
+		std::uint64_t next_epoch = 0;
+		std::deque<std::pair<std::uint64_t, sycl::event>> in_flight;
+
+		void Prune() {
+			while (!in_flight.empty() &&
+				in_flight.front().second.get_info<sycl::info::event::command_execution_status>() == sycl::info::event_command_status::complete)
+				in_flight.pop_front();
+		}
+
+	public:
+		void Track(const sycl::event& event) {
+			std::lock_guard lock(mutex);
+			Prune();
+			in_flight.emplace_back(next_epoch++, event);
+		}
+
+		std::uint64_t GetEpoch() {
+			std::lock_guard lock(mutex);
+			return next_epoch;
+		}
+
+		// every command submitted before the epoch has finished
+		bool IsComplete(std::uint64_t epoch) {
+			std::lock_guard lock(mutex);
+			Prune();
+			return in_flight.empty() || in_flight.front().first >= epoch;
+		}
+
+		void Wait(std::uint64_t epoch) {
+			std::vector<sycl::event> events;
+			{
+				std::lock_guard lock(mutex);
+				for (const auto& [submission_epoch, event] : in_flight)
+					if (submission_epoch < epoch)
+						events.push_back(event);
+			}
+			sycl::event::wait(events);
+		}
+	};
+
+	// caching USM allocator, released blocks are reused only when no command submitted before their release is running
+	class MemoryPool {
+		struct CachedBlock {
+			void* ptr;
+			std::uint64_t epoch;
+		};
+
+		// blocks of different allocation kinds are never interchanged
+		using BlockClass = std::pair<GALILEO_ALLOCATION_KIND, std::size_t>;
+
+		struct LiveBlock {
+			BlockClass block_class;
+			bool is_user_block;
+		};
+
+		static constexpr std::size_t alignment = 64;
+		static constexpr std::size_t min_size_class = 256;
+
+		sycl::queue& queue;
+		SubmissionTracker& tracker;
+		std::mutex mutex;
+		std::unordered_map<void*, LiveBlock> live_blocks;
+		std::map<BlockClass, std::deque<CachedBlock>> cached_blocks;
+		GALILEO_POOL_STATISTICS statistics{};
+
+		void ReleaseIdleBlocks() {
+			for (auto& [block_class, blocks] : cached_blocks) {
+				const auto size_class = block_class.second;
+				std::erase_if(blocks, [&](const CachedBlock& block) {
+					if (!tracker.IsComplete(block.epoch))
+						return false;
+					sycl::free(block.ptr, queue);
+					statistics.cached_bytes -= size_class;
+					statistics.reserved_bytes -= size_class;
+					return true;
+				});
+			}
+		}
+
+	public:
+		// four classes per power of two keep the internal fragmentation under 25%
+		static std::size_t GetSizeClass(std::size_t size) {
+			if (size <= min_size_class)
+				return min_size_class;
+			const auto step = std::bit_floor(size) / 4;
+			return (size + step - 1) / step * step;
+		}
+
+		MemoryPool(sycl::queue& queue, SubmissionTracker& tracker) : queue(queue), tracker(tracker) {}
+		MemoryPool(const MemoryPool&) = delete;
+		MemoryPool& operator=(const MemoryPool&) = delete;
+
+		// blocks handed out to the user stay valid, the user may still read them after the queue is released
+		~MemoryPool() {
+			for (const auto& [ptr, block] : live_blocks)
+				if (!block.is_user_block)
+					sycl::free(ptr, queue);
+			for (const auto& [block_class, blocks] : cached_blocks)
+				for (const auto& block : blocks)
+					sycl::free(block.ptr, queue);
+		}
+
+		void* Allocate(std::size_t size, GALILEO_ALLOCATION_KIND allocation_kind, bool is_user_block = false) {
+			const auto usm_kind = GetUsmKind(allocation_kind);
+			const auto size_class = GetSizeClass(size);
+			const auto block_class = BlockClass(allocation_kind, size_class);
+			std::lock_guard lock(mutex);
+			++statistics.allocations;
+
+			// blocks are cached in release order, the oldest one is the first to become idle
+			auto& blocks = cached_blocks[block_class];
+			if (!blocks.empty() && tracker.IsComplete(blocks.front().epoch)) {
+				auto ptr = blocks.front().ptr;
+				blocks.pop_front();
+				live_blocks.emplace(ptr, LiveBlock{ block_class, is_user_block });
+				++statistics.cache_hits;
+				statistics.cached_bytes -= size_class;
+				statistics.used_bytes += size_class;
+				return ptr;
+			}
+
+			auto ptr = sycl::aligned_alloc(alignment, size_class, queue, usm_kind);
+			if (!ptr) {
+				ReleaseIdleBlocks();
+				ptr = sycl::aligned_alloc(alignment, size_class, queue, usm_kind);
+				if (!ptr)
+					throw std::bad_alloc();
+			}
+			live_blocks.emplace(ptr, LiveBlock{ block_class, is_user_block });
+			++statistics.device_allocations;
+			statistics.reserved_bytes += size_class;
+			statistics.used_bytes += size_class;
+			return ptr;
+		}
+
+		bool Deallocate(void* ptr) {
+			std::lock_guard lock(mutex);
+			auto it = live_blocks.find(ptr);
+			if (it == live_blocks.end())
+				return false;
+
+			const auto block_class = it->second.block_class;
+			const auto size_class = block_class.second;
+			cached_blocks[block_class].push_back(CachedBlock{ ptr, tracker.GetEpoch() });
+			live_blocks.erase(it);
+			statistics.used_bytes -= size_class;
+			statistics.cached_bytes += size_class;
+			return true;
+		}
+
+		void Trim() {
+			std::lock_guard lock(mutex);
+			tracker.Wait(tracker.GetEpoch());
+			ReleaseIdleBlocks();
+		}
+
+		GALILEO_POOL_STATISTICS GetStatistics() {
+			std::lock_guard lock(mutex);
+			return statistics;
+		}
+	};
+}
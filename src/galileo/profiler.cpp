@@ -0,0 +1,129 @@
+#include "common.hpp"
+#include "context.hpp"
+#include "profiler.hpp"
+
+#include <fstream>
+
+namespace {
+	const char* GetDataTypeName(GALILEO_DATA_TYPE data_type) {
+		switch (data_type) {
+		case GALILEO_UINT8: return "uint8";
+		case GALILEO_UINT16: return "uint16";
+		case GALILEO_UINT32: return "uint32";
+		case GALILEO_UINT64: return "uint64";
+		case GALILEO_INT8: return "int8";
+		case GALILEO_INT16: return "int16";
+		case GALILEO_INT32: return "int32";
+		case GALILEO_INT64: return "int64";
+		case GALILEO_FLOAT: return "float";
+		case GALILEO_DOUBLE: return "double";
+		case GALILEO_HALF: return "half";
+		case GALILEO_COMPLEX_FLOAT: return "complex_float";
+		case GALILEO_COMPLEX_DOUBLE: return "complex_double";
+		case GALILEO_COMPLEX_HALF: return "complex_half";
+		case GALILEO_BFLOAT16: return "bfloat16";
+		default: return "unknown";
+		}
+	}
+}
+
+GALILEO_RESULT GALILEO_SetProfiling(GALILEO_QUEUE queue, int enable) {
+	try {
+		if (!queue)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		galileo::common::GetQueueContext(queue).profiler.SetEnabled(enable != 0);
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+	return GALILEO_RESULT::GALILEO_RESULT_OK;
+}
+
+// with statistics set to nullptr only the number of op and data type pairs is returned, otherwise up to *count of them are filled in
+// the device times are read from the events, so the pending ops are waited for
+GALILEO_RESULT GALILEO_GetStats(GALILEO_QUEUE queue, GALILEO_OP_STATISTICS* statistics, unsigned int* count) {
+	try {
+		if (!queue || !count)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		const auto entries = galileo::common::GetQueueContext(queue).profiler.GetStatistics();
+		if (!statistics) {
+			*count = static_cast<unsigned int>(entries.size());
+			return GALILEO_RESULT::GALILEO_RESULT_OK;
+		}
+
+		unsigned int filled = 0;
+		for (auto it = entries.begin(); it != entries.end() && filled < *count; ++it)
+			statistics[filled++] = *it;
+		*count = filled;
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+	return GALILEO_RESULT::GALILEO_RESULT_OK;
+}
+
+GALILEO_RESULT GALILEO_ResetStats(GALILEO_QUEUE queue) {
+	try {
+		if (!queue)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		galileo::common::GetQueueContext(queue).profiler.Reset();
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+	return GALILEO_RESULT::GALILEO_RESULT_OK;
+}
+
+// chrome://tracing and Perfetto format, the timestamps are microseconds of std::chrono::steady_clock
+// host calls go to thread 0 and device commands to thread 1, placed after their host submission by the delay the device reports
+// only the last Profiler::max_trace_size calls are kept, the statistics cover all of them
+GALILEO_RESULT GALILEO_WriteTrace(GALILEO_QUEUE queue, const char* path) {
+	try {
+		if (!queue || !path)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		auto& profiler = galileo::common::GetQueueContext(queue).profiler;
+		std::ofstream trace(path);
+		if (!trace)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		auto write_event = [&, is_first = true](const char* name, GALILEO_DATA_TYPE data_type, int thread, double start, double duration, unsigned long long bytes) mutable {
+			trace << (is_first ? "\n" : ",\n") << "{\"name\":\"" << name << "\",\"cat\":\"galileo\",\"ph\":\"X\",\"pid\":0,\"tid\":" << thread
+				<< ",\"ts\":" << start << ",\"dur\":" << duration
+				<< ",\"args\":{\"type\":\"" << GetDataTypeName(data_type) << "\",\"bytes\":" << bytes << "}}";
+			is_first = false;
+		};
+
+		trace << std::fixed << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+		for (const auto& entry : profiler.GetTrace()) {
+			const auto start = galileo::common::GetMicroseconds(entry.start.time_since_epoch());
+			write_event(entry.name, entry.data_type, 0, start, galileo::common::GetMicroseconds(entry.submitted - entry.start), entry.bytes);
+			if (profiler.HasDeviceTimes()) {
+				const auto submit = galileo::common::GetMicroseconds(entry.validated.time_since_epoch());
+				write_event(entry.name, entry.data_type, 1, submit + entry.delay_microseconds, entry.device_microseconds, entry.bytes);
+			}
+		}
+		trace << "\n]}\n";
+		if (!trace)
+			return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+	return GALILEO_RESULT::GALILEO_RESULT_OK;
+}
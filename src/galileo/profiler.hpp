@@ -0,0 +1,225 @@
+#pragma once
+
+#include "common.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace galileo::common {
+	using ProfileClock = std::chrono::steady_clock;
+
+	// collects the events of every command the calling thread submits while an op is profiled, see ProfileOp
+	// an op profiled inside another one hands its events over to the outer op as well
+	class ProfileScope {
+		inline static thread_local std::vector<sycl::event>* active = nullptr;
+		std::vector<sycl::event>* previous;
+		std::vector<sycl::event> events;
+
+	public:
+		ProfileScope() : previous(active) {
+			active = &events;
+		}
+
+		~ProfileScope() {
+			active = previous;
+			if (previous)
+				previous->insert(previous->end(), events.begin(), events.end());
+		}
+
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+
+		static void Collect(const sycl::event& event) {
+			if (active)
+				active->push_back(event);
+		}
+
+		const std::vector<sycl::event>& GetEvents() const {
+			return events;
+		}
+	};
+
+	// one op call of a profiled queue, its device time spans the commands it submitted
+	struct ProfileRecord {
+		const char* name;
+		GALILEO_DATA_TYPE data_type;
+		ProfileClock::time_point start;
+		ProfileClock::time_point validated;
+		ProfileClock::time_point submitted;
+		unsigned long long bytes;
+		std::vector<sycl::event> events;
+	};
+
+	// a record once its device times are read, as the trace keeps it
+	struct ProfileTraceEntry {
+		const char* name;
+		GALILEO_DATA_TYPE data_type;
+		ProfileClock::time_point start;
+		ProfileClock::time_point validated;
+		ProfileClock::time_point submitted;
+		unsigned long long bytes;
+		double device_microseconds;
+		double delay_microseconds;
+	};
+
+	inline double GetMicroseconds(ProfileClock::duration duration) {
+		return std::chrono::duration<double, std::micro>(duration).count();
+	}
+
+	inline bool AreComplete(const std::vector<sycl::event>& events) {
+		return std::all_of(events.begin(), events.end(), [](const sycl::event& event) {
+			return event.get_info<sycl::info::event::command_execution_status>() == sycl::info::event_command_status::complete;
+			});
+	}
+
+	// from the first command start to the last command end of the record, and the delay of the first start after the first submission
+	// waits for the commands, ops run on the host have none and report zeros, as do commands without profiling info (barriers on some backends)
+	inline std::pair<double, double> GetDeviceMicroseconds(const ProfileRecord& record) {
+		auto submit = std::numeric_limits<std::uint64_t>::max();
+		auto start = std::numeric_limits<std::uint64_t>::max();
+		std::uint64_t end = 0;
+		for (const auto& event : record.events) {
+			try {
+				event.wait();
+				const auto command_submit = event.get_profiling_info<sycl::info::event_profiling::command_submit>();
+				const auto command_start = event.get_profiling_info<sycl::info::event_profiling::command_start>();
+				const auto command_end = event.get_profiling_info<sycl::info::event_profiling::command_end>();
+				submit = std::min<std::uint64_t>(submit, command_submit);
+				start = std::min<std::uint64_t>(start, command_start);
+				end = std::max<std::uint64_t>(end, command_end);
+			}
+			catch (const sycl::exception&) {
+			}
+		}
+		if (end < start)
+			return { 0., 0. };
+		return { (end - start) / 1e3, (start - std::min(submit, start)) / 1e3 };
+	}
+
+	inline void AddToHistogram(unsigned long long(&histogram)[GALILEO_STATISTICS_HISTOGRAM_SIZE], double microseconds) {
+		const auto bucket = static_cast<std::size_t>(std::bit_width(static_cast<unsigned long long>(microseconds)));
+		++histogram[std::min<std::size_t>(bucket, GALILEO_STATISTICS_HISTOGRAM_SIZE - 1)];
+	}
+
+	// opt-in per-queue instrumentation of the op entry points, enabled by GALILEO_SetProfiling or the GALILEO_PROFILING environment variable
+	// the statistics are aggregated as the records complete and only the last max_trace_size records are kept for the trace,
+	// so a long profiled run holds a bounded amount of memory
+	class Profiler {
+	public:
+		static constexpr std::size_t max_trace_size = 1 << 16;
+		// records whose commands are still running, the oldest one is waited for beyond that
+		static constexpr std::size_t max_pending_size = 1 << 12;
+
+	private:
+		std::mutex mutex;
+		std::deque<ProfileRecord> pending;
+		std::map<std::pair<std::string, GALILEO_DATA_TYPE>, GALILEO_OP_STATISTICS> statistics;
+		// ring buffer, trace_next is the slot of the next entry once it is full
+		std::vector<ProfileTraceEntry> trace;
+		std::size_t trace_next = 0;
+		std::atomic<bool> enabled = IsEnabledByEnvironment();
+		// device times are only reported by queues created with enable_profiling
+		const bool has_device_times;
+
+		void Resolve(const ProfileRecord& record) {
+			const auto [device_microseconds, delay_microseconds] = has_device_times ? GetDeviceMicroseconds(record) : std::pair{ 0., 0. };
+			auto& entry = statistics[{ record.name, record.data_type }];
+			if (!entry.calls) {
+				const auto length = std::min(std::char_traits<char>::length(record.name), sizeof(entry.name) - 1);
+				std::copy_n(record.name, length, entry.name);
+				entry.data_type = record.data_type;
+			}
+			++entry.calls;
+			entry.bytes += record.bytes;
+			entry.validation_microseconds += GetMicroseconds(record.validated - record.start);
+			entry.submit_microseconds += GetMicroseconds(record.submitted - record.validated);
+			AddToHistogram(entry.host_histogram, GetMicroseconds(record.submitted - record.start));
+			if (has_device_times) {
+				entry.device_microseconds += device_microseconds;
+				AddToHistogram(entry.device_histogram, device_microseconds);
+			}
+
+			ProfileTraceEntry trace_entry{ record.name, record.data_type, record.start, record.validated, record.submitted, record.bytes, device_microseconds, delay_microseconds };
+			if (trace.size() < max_trace_size)
+				trace.push_back(trace_entry);
+			else
+				trace[trace_next] = trace_entry;
+			trace_next = (trace_next + 1) % max_trace_size;
+		}
+
+		// the finished records are read without blocking, wait_all waits for the rest
+		void ResolvePending(bool wait_all) {
+			while (!pending.empty() && (wait_all || pending.size() > max_pending_size || !has_device_times || AreComplete(pending.front().events))) {
+				Resolve(pending.front());
+				pending.pop_front();
+			}
+		}
+
+	public:
+		explicit Profiler(const sycl::queue& queue) : has_device_times(queue.has_property<sycl::property::queue::enable_profiling>()) {}
+
+		static bool IsEnabledByEnvironment() {
+			const auto value = std::getenv("GALILEO_PROFILING");
+			return value && *value && *value != '0';
+		}
+
+		void SetEnabled(bool is_enabled) {
+			enabled = is_enabled;
+		}
+
+		bool IsEnabled() const {
+			return enabled;
+		}
+
+		bool HasDeviceTimes() const {
+			return has_device_times;
+		}
+
+		void Record(ProfileRecord record) {
+			std::lock_guard lock(mutex);
+			pending.push_back(std::move(record));
+			ResolvePending(false);
+		}
+
+		// waits for the pending records
+		std::vector<GALILEO_OP_STATISTICS> GetStatistics() {
+			std::lock_guard lock(mutex);
+			ResolvePending(true);
+			std::vector<GALILEO_OP_STATISTICS> entries;
+			entries.reserve(statistics.size());
+			for (const auto& [key, entry] : statistics)
+				entries.push_back(entry);
+			return entries;
+		}
+
+		// the kept records from the oldest on, waits for the pending ones
+		std::vector<ProfileTraceEntry> GetTrace() {
+			std::lock_guard lock(mutex);
+			ResolvePending(true);
+			if (trace.size() < max_trace_size)
+				return trace;
+			std::vector<ProfileTraceEntry> entries(trace.begin() + trace_next, trace.end());
+			entries.insert(entries.end(), trace.begin(), trace.begin() + trace_next);
+			return entries;
+		}
+
+		void Reset() {
+			std::lock_guard lock(mutex);
+			pending.clear();
+			statistics.clear();
+			trace.clear();
+			trace_next = 0;
+		}
+	};
+}
@@ -0,0 +1,47 @@
+#include "common.hpp"
+#include "context.hpp"
+#include "reduce.hpp"
+
+#define REDUCE_FUNCTION_DEF(EXT_NAME, ASYNC_EXT_NAME, KERNEL_NAME) GALILEO_RESULT ASYNC_EXT_NAME(const GALILEO_TENSOR* input, int axis, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event) { \
+	try { \
+		const auto profile_start = galileo::common::ProfileClock::now(); \
+		if (!input || !output || !input->tensor_data || !output->tensor_data) \
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER; \
+	 \
+		if (!galileo::common::VerifyQueryPtrs(*input, *output)) \
+			return GALILEO_RESULT::GALILEO_RESULT_TENSOR_QUEUE_MISMATCH; \
+	 \
+		auto queue = input->associated_queue; \
+	 \
+		const auto input_ptr_state = galileo::common::VerifyTensor(*input); \
+		const auto output_ptr_state = galileo::common::VerifyTensor(*output); \
+		if (!input_ptr_state || !output_ptr_state) \
+			return GALILEO_RESULT_NON_USM_POINTER; \
+	\
+		auto dependencies = galileo::common::GetEvents(wait_events, wait_events_size); \
+		auto make_reduction = [axis](GALILEO_TENSOR* tensors) { return KERNEL_NAME(tensors[0], axis, tensors[1]); }; \
+		galileo::common::SetEvent(event, galileo::common::ProfileOp(queue, #KERNEL_NAME, profile_start, std::array{ *input, *output }, [&](const auto& op_tensors) { return galileo::common::SubmitOp(queue, op_tensors, make_reduction, dependencies); })); \
+	} \
+	catch (GALILEO_RESULT res) { \
+		return res; \
+	} \
+	catch (...) { \
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR; \
+	} \
+	return GALILEO_RESULT::GALILEO_RESULT_OK; \
+} \
+GALILEO_RESULT EXT_NAME(const GALILEO_TENSOR* input, int axis, GALILEO_TENSOR* output) { \
+	return ASYNC_EXT_NAME(input, axis, output, nullptr, 0, nullptr); \
+}
+#define CREATE_EXT_NAME( s ) GALILEO_ ## s
+#define CREATE_ASYNC_EXT_NAME( s ) GALILEO_ ## s ## Async
+#define REDUCE_FUNCTION(NAME) REDUCE_FUNCTION_DEF(CREATE_EXT_NAME(NAME), CREATE_ASYNC_EXT_NAME(NAME), NAME)
+
+REDUCE_FUNCTION(Sum)
+REDUCE_FUNCTION(Prod)
+REDUCE_FUNCTION(Min)
+REDUCE_FUNCTION(Max)
+REDUCE_FUNCTION(Mean)
+REDUCE_FUNCTION(Norm)
+REDUCE_FUNCTION(ArgMin)
+REDUCE_FUNCTION(ArgMax)
@@ -0,0 +1,269 @@
+#pragma once
+
+#include "common.hpp"
+#include "context.hpp"
+#include "types.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+namespace galileo {
+	inline namespace detail {
+		// infinities for the floating-point types, so that an input of infinities reduces to itself
+		template <typename T>
+		constexpr T GetUpperBound() {
+			if constexpr (std::numeric_limits<T>::has_infinity)
+				return std::numeric_limits<T>::infinity();
+			else
+				return std::numeric_limits<T>::max();
+		}
+
+		template <typename T>
+		constexpr T GetLowerBound() {
+			if constexpr (std::numeric_limits<T>::has_infinity)
+				return -std::numeric_limits<T>::infinity();
+			else
+				return std::numeric_limits<T>::lowest();
+		}
+
+		// NaN is the only value unequal to itself, integers never are
+		template <typename T>
+		bool IsNan(T value) {
+			return value != value;
+		}
+
+		template <typename T>
+		struct IndexedValue {
+			T value;
+			std::int64_t index;
+		};
+
+		// every reduction is described by the partial state, its identity, how an element enters it and how two states merge
+		struct SumReduction {
+			template <typename T> using State = accumulator_t<T>;
+			template <typename T> static State<T> Identity() { return State<T>(0); }
+			template <typename T> static State<T> Map(T value, std::int64_t) { return static_cast<State<T>>(value); }
+			template <typename S> static S Combine(S lhs, S rhs) { return lhs + rhs; }
+			template <typename S> static S Finalize(S state, std::size_t) { return state; }
+		};
+
+		struct ProdReduction : SumReduction {
+			template <typename T> static State<T> Identity() { return State<T>(1); }
+			template <typename S> static S Combine(S lhs, S rhs) { return lhs * rhs; }
+		};
+
+		// NaN propagates, whatever order the states are combined in
+		struct MinReduction : SumReduction {
+			template <typename T> static State<T> Identity() { return GetUpperBound<State<T>>(); }
+			template <typename S> static S Combine(S lhs, S rhs) { return IsNan(rhs) || rhs < lhs ? rhs : lhs; }
+		};
+
+		struct MaxReduction : SumReduction {
+			template <typename T> static State<T> Identity() { return GetLowerBound<State<T>>(); }
+			template <typename S> static S Combine(S lhs, S rhs) { return IsNan(rhs) || lhs < rhs ? rhs : lhs; }
+		};
+
+		struct MeanReduction : SumReduction {
+			template <typename S> static S Finalize(S state, std::size_t count) { return state / static_cast<S>(count); }
+		};
+
+		struct NormReduction : SumReduction {
+			template <typename T> static State<T> Map(T value, std::int64_t) { return static_cast<State<T>>(value) * static_cast<State<T>>(value); }
+			template <typename S> static S Finalize(S state, std::size_t) { return sycl::sqrt(state); }
+		};
+
+		// ties are resolved towards the first occurrence, the first NaN wins like it does for Min and Max
+		// the identity holds index 0, it only survives an input made of the bound itself, whose first occurrence is index 0 as well
+		template <bool is_min>
+		struct ArgReduction {
+			template <typename T> using State = IndexedValue<accumulator_t<T>>;
+			template <typename T> static State<T> Identity() {
+				using value_type = accumulator_t<T>;
+				return { is_min ? GetUpperBound<value_type>() : GetLowerBound<value_type>(), 0 };
+			}
+			template <typename T> static State<T> Map(T value, std::int64_t index) { return { static_cast<accumulator_t<T>>(value), index }; }
+			template <typename S> static S Combine(S lhs, S rhs) {
+				const auto is_lhs_nan = IsNan(lhs.value);
+				const auto is_rhs_nan = IsNan(rhs.value);
+				if (is_lhs_nan || is_rhs_nan)
+					return is_rhs_nan && (!is_lhs_nan || rhs.index < lhs.index) ? rhs : lhs;
+				const auto is_better = is_min ? rhs.value < lhs.value : lhs.value < rhs.value;
+				return is_better || (rhs.value == lhs.value && rhs.index < lhs.index) ? rhs : lhs;
+			}
+			template <typename S> static std::int64_t Finalize(S state, std::size_t) { return state.index; }
+		};
+
+		// axes at least this long are reduced by a work-group per output element
+		constexpr std::size_t min_group_axis_size = 1024;
+		constexpr std::size_t max_reduce_group_size = 256;
+
+		template <TypesToUse types_to_use, typename Reduction, bool is_indexed = false>
+		struct ReduceOp {
+		protected:
+			using reduce_types = enabled_data_types_t<eltwise_types_t<types_to_use>>;
+			// indices are always reported as int64
+			using output_types = std::conditional_t<is_indexed, std::tuple<std::int64_t>, reduce_types>;
+
+			template <typename T, typename U>
+			sycl::event ProcessFull(GALILEO_QUEUE queue, const T* input_ptr, U* output_ptr, const std::vector<sycl::event>& dependencies) const {
+				using State = typename Reduction::template State<T>;
+				const std::size_t size = axis_size;
+				const auto is_contiguous = this->is_contiguous;
+				const auto indexer = this->indexer;
+
+				// the partial states live in a pooled scratch block, released right after the submission
+				// a sharded queue reduces one part of the range per shard into its own state, the finalize step combines them
+				auto& context = common::GetQueueContext(queue);
+				auto shards_size = common::GetShardCount(queue, size);
+				// device allocations are only reachable from the device they were made for
+				if (context.is_multi_device && common::GetPointerKind(queue, input_ptr) == GALILEO_ALLOCATION_DEVICE)
+					shards_size = 1;
+				const auto state_kind = context.is_multi_device && shards_size > 1 ? GALILEO_ALLOCATION_SHARED : GALILEO_ALLOCATION_DEVICE;
+				auto state_ptr = static_cast<State*>(context.pool.Allocate(shards_size * sizeof(State), state_kind));
+
+				auto make_reduce = [=](std::size_t shard) {
+					const auto begin = common::GetShardBegin(size, shard, shards_size);
+					const auto end = common::GetShardBegin(size, shard + 1, shards_size);
+					return [=](sycl::handler& h) {
+						auto reduction = sycl::reduction(state_ptr + shard, Reduction::template Identity<T>(),
+							[](State lhs, State rhs) { return Reduction::Combine(lhs, rhs); },
+							sycl::property::reduction::initialize_to_identity());
+						h.parallel_for(sycl::range<1>(end - begin), reduction, [=](sycl::id<1> i, auto& state) {
+							const auto index = begin + i[0];
+							const auto offset = is_contiguous ? index : indexer.GetOffsets(index)[0];
+							state.combine(Reduction::Map(input_ptr[offset], static_cast<std::int64_t>(index)));
+							});
+					};
+				};
+				auto finalize = [=](sycl::handler& h) {
+					h.single_task([=]() {
+						auto state = state_ptr[0];
+						for (std::size_t shard = 1; shard < shards_size; ++shard)
+							state = Reduction::Combine(state, state_ptr[shard]);
+						*output_ptr = common::Convert<U>(Reduction::Finalize(state, size));
+						});
+				};
+
+				std::vector<sycl::event> events;
+				if (shards_size == 1) {
+					auto reduce = make_reduce(0);
+					events.push_back(common::Submit(queue, reduce, dependencies));
+				}
+				else {
+					for (std::size_t shard = 0; shard < shards_size; ++shard) {
+						auto reduce = make_reduce(shard);
+						events.push_back(common::SubmitShard(queue, shard, reduce, dependencies));
+					}
+				}
+				auto event = common::Submit(queue, finalize, events);
+				common::ReleaseScratch(queue, state_ptr);
+				return event;
+			}
+
+			// a long axis is split over a work-group per output element, a short one is walked by one work-item per output element
+			template <typename T, typename U>
+			sycl::event ProcessAxis(GALILEO_QUEUE queue, const T* input_ptr, U* output_ptr, const std::vector<sycl::event>& dependencies) const {
+				using State = typename Reduction::template State<T>;
+				const std::size_t axis_size = this->axis_size;
+				const std::size_t inner_size = this->inner_size;
+				const std::size_t output_size = outer_size * inner_size;
+				const auto is_contiguous = this->is_contiguous;
+				const auto indexer = this->indexer;
+				auto get_offset = [=](std::size_t output, std::size_t j) {
+					const auto index = (output / inner_size * axis_size + j) * inner_size + output % inner_size;
+					return is_contiguous ? index : indexer.GetOffsets(index)[0];
+				};
+
+				if (axis_size >= min_group_axis_size) {
+					const auto max_group_size = common::GetQueue(queue).get_device().template get_info<sycl::info::device::max_work_group_size>();
+					const auto group_size = std::bit_floor(std::min(max_group_size, max_reduce_group_size));
+					auto reduce = [=](sycl::handler& h) {
+						sycl::local_accessor<State, 1> states(sycl::range<1>(group_size), h);
+						h.parallel_for(sycl::nd_range<1>(output_size * group_size, group_size), [=](sycl::nd_item<1> item) {
+							const auto output = item.get_group_linear_id();
+							const auto local = item.get_local_linear_id();
+							auto state = Reduction::template Identity<T>();
+							for (std::size_t j = local; j < axis_size; j += group_size)
+								state = Reduction::Combine(state, Reduction::Map(input_ptr[get_offset(output, j)], static_cast<std::int64_t>(j)));
+							// the combiners are arbitrary functions, so the tree runs in local memory rather than through the group algorithms
+							states[local] = state;
+							for (auto stride = group_size / 2; stride > 0; stride /= 2) {
+								sycl::group_barrier(item.get_group());
+								if (local < stride)
+									states[local] = Reduction::Combine(states[local], states[local + stride]);
+							}
+							if (local == 0)
+								output_ptr[output] = common::Convert<U>(Reduction::Finalize(states[0], axis_size));
+							});
+					};
+					return common::Submit(queue, reduce, dependencies);
+				}
+
+				// neighbouring items read neighbouring inner elements
+				auto reduce = [=](sycl::handler& h) {
+					h.parallel_for(sycl::range<1>(output_size), [=](sycl::id<1> i) {
+						auto state = Reduction::template Identity<T>();
+						for (std::size_t j = 0; j < axis_size; ++j)
+							state = Reduction::Combine(state, Reduction::Map(input_ptr[get_offset(i[0], j)], static_cast<std::int64_t>(j)));
+						output_ptr[i] = common::Convert<U>(Reduction::Finalize(state, axis_size));
+						});
+				};
+				return common::Submit(queue, reduce, dependencies);
+			}
+
+		public:
+			using InputType = decltype(common::GetVariantFromTuple<true>(std::declval<variant_types_t<reduce_types>>()));
+			using OutputType = decltype(common::GetVariantFromTuple<false>(std::declval<variant_types_t<output_types>>()));
+
+			InputType input;
+			OutputType output;
+			bool is_full;
+			std::size_t outer_size = 1;
+			std::size_t axis_size = 1;
+			std::size_t inner_size = 1;
+			bool is_contiguous;
+			common::StridedIndexer<1> indexer;
+
+			// negative axis reduces the whole tensor into a single element
+			ReduceOp(const GALILEO_TENSOR& input, int axis, GALILEO_TENSOR& output) :
+				input(GetVariantFromTypes<true, InputType, reduce_types>(input.tensor_data, input.data_type)),
+				output(GetVariantFromTypes<false, OutputType, output_types>(output.tensor_data, output.data_type)),
+				is_full(axis < 0),
+				is_contiguous(common::IsContiguous(input.dimensions)),
+				indexer(input.dimensions, { &input.dimensions }) {
+				const auto& dimensions = input.dimensions;
+				const auto total_size = common::GetTotalSize(dimensions);
+				if (total_size == 0 || (!is_full && static_cast<unsigned int>(axis) >= dimensions.tensor_dimensions_size))
+					throw GALILEO_RESULT::GALILEO_RESULT_TENSOR_DIMENSIONS_MISMATCH;
+
+				if (is_full)
+					axis_size = total_size;
+				else {
+					for (int i = 0; i < axis; ++i)
+						outer_size *= dimensions.tensor_dimensions[i];
+					axis_size = dimensions.tensor_dimensions[axis];
+					inner_size = total_size / outer_size / axis_size;
+				}
+				// the output holds the remaining dimensions in the row-major order, kept or squeezed
+				if (common::GetTotalSize(output.dimensions) != outer_size * inner_size || !common::IsContiguous(output.dimensions))
+					throw GALILEO_RESULT::GALILEO_RESULT_TENSOR_DIMENSIONS_MISMATCH;
+			}
+
+			sycl::event Submit(GALILEO_QUEUE queue, const std::vector<sycl::event>& dependencies) const {
+				return std::visit([&](const auto* input_ptr, auto* output_ptr) {
+					return is_full ? ProcessFull(queue, input_ptr, output_ptr, dependencies) : ProcessAxis(queue, input_ptr, output_ptr, dependencies);
+					}, input, output);
+			}
+		};
+	}
+}
+
+using Sum = galileo::ReduceOp < galileo::TypesToUse::FpWithIntegers, galileo::SumReduction > ;
+using Prod = galileo::ReduceOp < galileo::TypesToUse::FpWithIntegers, galileo::ProdReduction > ;
+using Min = galileo::ReduceOp < galileo::TypesToUse::FpWithIntegers, galileo::MinReduction > ;
+using Max = galileo::ReduceOp < galileo::TypesToUse::FpWithIntegers, galileo::MaxReduction > ;
+using Mean = galileo::ReduceOp < galileo::TypesToUse::OnlyFp, galileo::MeanReduction > ;
+using Norm = galileo::ReduceOp < galileo::TypesToUse::OnlyFp, galileo::NormReduction > ;
+using ArgMin = galileo::ReduceOp < galileo::TypesToUse::FpWithIntegers, galileo::ArgReduction<true>, true > ;
+using ArgMax = galileo::ReduceOp < galileo::TypesToUse::FpWithIntegers, galileo::ArgReduction<false>, true > ;
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "common.hpp"
+
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <shared_mutex>
+
+namespace galileo::common {
+	// address ranges known to be valid USM for the queue, replaces the runtime lookup on the hot path
+	class PointerRegistry {
+		struct Entry {
+			std::size_t size;
+			GALILEO_ALLOCATION_KIND allocation_kind;
+		};
+
+		std::shared_mutex mutex;
+		std::map<std::uintptr_t, Entry> entries;
+
+	public:
+		void Register(const void* ptr, std::size_t size, GALILEO_ALLOCATION_KIND allocation_kind) {
+			std::unique_lock lock(mutex);
+			entries.insert_or_assign(reinterpret_cast<std::uintptr_t>(ptr), Entry{ size, allocation_kind });
+		}
+
+		bool Unregister(const void* ptr) {
+			std::unique_lock lock(mutex);
+			return entries.erase(reinterpret_cast<std::uintptr_t>(ptr)) != 0;
+		}
+
+		// pointers inside a registered range (views) are resolved as well
+		std::optional<GALILEO_ALLOCATION_KIND> Find(const void* ptr) {
+			const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+			std::shared_lock lock(mutex);
+			auto it = entries.upper_bound(address);
+			if (it == entries.begin())
+				return std::nullopt;
+			--it;
+			if (address - it->first >= std::max<std::size_t>(it->second.size, 1))
+				return std::nullopt;
+			return it->second.allocation_kind;
+		}
+
+		// bytes from a pointer inside a registered range to the end of the range
+		std::optional<std::size_t> GetRemainingSize(const void* ptr) {
+			const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+			std::shared_lock lock(mutex);
+			auto it = entries.upper_bound(address);
+			if (it == entries.begin())
+				return std::nullopt;
+			--it;
+			const auto offset = address - it->first;
+			if (offset >= std::max<std::size_t>(it->second.size, 1))
+				return std::nullopt;
+			return it->second.size - offset;
+		}
+	};
+
+	// registered host memory the device can't reach, tensors created on it run on a device copy
+	class HostMirrorRegistry {
+	public:
+		struct Entry {
+			std::size_t size;
+			void* mirror;
+		};
+
+	private:
+		std::shared_mutex mutex;
+		std::map<std::uintptr_t, Entry> entries;
+
+	public:
+		void Register(const void* ptr, std::size_t size, void* mirror) {
+			std::unique_lock lock(mutex);
+			entries.insert_or_assign(reinterpret_cast<std::uintptr_t>(ptr), Entry{ size, mirror });
+		}
+
+		std::optional<Entry> Unregister(const void* ptr) {
+			std::unique_lock lock(mutex);
+			auto it = entries.find(reinterpret_cast<std::uintptr_t>(ptr));
+			if (it == entries.end())
+				return std::nullopt;
+			auto entry = it->second;
+			entries.erase(it);
+			return entry;
+		}
+
+		// address in the device copy matching a pointer inside a registered range, nullptr otherwise
+		void* Translate(const void* ptr) {
+			const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+			std::shared_lock lock(mutex);
+			auto it = entries.upper_bound(address);
+			if (it == entries.begin())
+				return nullptr;
+			--it;
+			const auto offset = address - it->first;
+			if (offset >= it->second.size)
+				return nullptr;
+			return static_cast<std::byte*>(it->second.mirror) + offset;
+		}
+
+		std::optional<std::size_t> GetRemainingSize(const void* ptr) {
+			const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+			std::shared_lock lock(mutex);
+			auto it = entries.upper_bound(address);
+			if (it == entries.begin())
+				return std::nullopt;
+			--it;
+			const auto offset = address - it->first;
+			if (offset >= it->second.size)
+				return std::nullopt;
+			return it->second.size - offset;
+		}
+	};
+}
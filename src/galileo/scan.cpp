@@ -0,0 +1,71 @@
+#include "common.hpp"
+#include "context.hpp"
+#include "scan.hpp"
+
+GALILEO_RESULT GALILEO_CumSumAsync(const GALILEO_TENSOR* input, GALILEO_SCAN_MODE mode, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event) {
+	try {
+		const auto profile_start = galileo::common::ProfileClock::now();
+		if (!input || !output || !input->tensor_data || !output->tensor_data)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		if (!galileo::common::VerifyQueryPtrs(*input, *output))
+			return GALILEO_RESULT::GALILEO_RESULT_TENSOR_QUEUE_MISMATCH;
+
+		auto queue = input->associated_queue;
+
+		const auto input_ptr_state = galileo::common::VerifyTensor(*input);
+		const auto output_ptr_state = galileo::common::VerifyTensor(*output);
+		if (!input_ptr_state || !output_ptr_state)
+			return GALILEO_RESULT_NON_USM_POINTER;
+
+		auto dependencies = galileo::common::GetEvents(wait_events, wait_events_size);
+		auto make_scan = [mode](GALILEO_TENSOR* tensors) { return CumSum(tensors[0], mode, tensors[1]); };
+		galileo::common::SetEvent(event, galileo::common::ProfileOp(queue, "CumSum", profile_start, std::array{ *input, *output }, [&](const auto& op_tensors) { return galileo::common::SubmitOp(queue, op_tensors, make_scan, dependencies); }));
+	}
+	catch (GALILEO_RESULT res) {
+		return res;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+	return GALILEO_RESULT::GALILEO_RESULT_OK;
+}
+
+GALILEO_RESULT GALILEO_CumSum(const GALILEO_TENSOR* input, GALILEO_SCAN_MODE mode, GALILEO_TENSOR* output) {
+	return GALILEO_CumSumAsync(input, mode, output, nullptr, 0, nullptr);
+}
+
+GALILEO_RESULT GALILEO_CompactAsync(const GALILEO_TENSOR* input, const GALILEO_TENSOR* mask, GALILEO_TENSOR* output, GALILEO_TENSOR* count, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event) {
+	try {
+		const auto profile_start = galileo::common::ProfileClock::now();
+		if (!input || !mask || !output || !count || !input->tensor_data || !mask->tensor_data || !output->tensor_data || !count->tensor_data)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		if (!galileo::common::VerifyQueryPtrs(*input, *mask, *output, *count))
+			return GALILEO_RESULT::GALILEO_RESULT_TENSOR_QUEUE_MISMATCH;
+
+		auto queue = input->associated_queue;
+
+		const auto input_ptr_state = galileo::common::VerifyTensor(*input);
+		const auto mask_ptr_state = galileo::common::VerifyTensor(*mask);
+		const auto output_ptr_state = galileo::common::VerifyTensor(*output);
+		const auto count_ptr_state = galileo::common::VerifyTensor(*count);
+		if (!input_ptr_state || !mask_ptr_state || !output_ptr_state || !count_ptr_state)
+			return GALILEO_RESULT_NON_USM_POINTER;
+
+		auto dependencies = galileo::common::GetEvents(wait_events, wait_events_size);
+		auto make_compact = [](GALILEO_TENSOR* tensors) { return Compact(tensors[0], tensors[1], tensors[2], tensors[3]); };
+		galileo::common::SetEvent(event, galileo::common::ProfileOp(queue, "Compact", profile_start, std::array{ *input, *mask, *output, *count }, [&](const auto& op_tensors) { return galileo::common::SubmitOp(queue, op_tensors, make_compact, dependencies); }));
+	}
+	catch (GALILEO_RESULT res) {
+		return res;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+	return GALILEO_RESULT::GALILEO_RESULT_OK;
+}
+
+GALILEO_RESULT GALILEO_Compact(const GALILEO_TENSOR* input, const GALILEO_TENSOR* mask, GALILEO_TENSOR* output, GALILEO_TENSOR* count) {
+	return GALILEO_CompactAsync(input, mask, output, count, nullptr, 0, nullptr);
+}
@@ -0,0 +1,183 @@
+#pragma once
+
+#include "common.hpp"
+#include "context.hpp"
+#include "types.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace galileo {
+	inline namespace detail {
+		// the work-group size is clamped to the device limit at run time, a block is what a work-group scans
+		constexpr std::size_t max_scan_group_size = 256;
+		constexpr std::size_t scan_items_per_work_item = 8;
+
+		// block totals are scanned in place, fixed types keep the recursion from instantiating new templates
+		template <typename State>
+		struct BlockOffsetsLoad {
+			State* block_offsets;
+			State operator()(std::size_t i) const { return block_offsets[i]; }
+		};
+
+		template <typename State>
+		struct BlockOffsetsStore {
+			State* block_offsets;
+			void operator()(std::size_t i, State prefix, State) const { block_offsets[i] = prefix; }
+		};
+
+		// reduce-then-scan: block totals, their exclusive scan (recursively), and the final pass seeded by the block offset
+		// store receives the exclusive prefix and the loaded value of every element exactly once
+		template <typename State, typename Load, typename Store>
+		sycl::event BlockScan(GALILEO_QUEUE queue, std::size_t size, Load load, Store store, const std::vector<sycl::event>& dependencies) {
+			const auto max_group_size = common::GetQueue(queue).get_device().get_info<sycl::info::device::max_work_group_size>();
+			const auto group_size = std::bit_floor(std::min(max_group_size, max_scan_group_size));
+			const auto block_size = group_size * scan_items_per_work_item;
+			const auto blocks = (size + block_size - 1) / block_size;
+			const sycl::nd_range<1> range(blocks * group_size, group_size);
+
+			auto& pool = common::GetQueueContext(queue).pool;
+			State* block_offsets = nullptr;
+			auto scan_dependencies = dependencies;
+			if (blocks > 1) {
+				block_offsets = static_cast<State*>(pool.Allocate(blocks * sizeof(State), GALILEO_ALLOCATION_DEVICE));
+				auto reduce = [=](sycl::handler& h) {
+					h.parallel_for(range, [=](sycl::nd_item<1> item) {
+						const auto begin = item.get_global_id(0) * scan_items_per_work_item;
+						State total = 0;
+						for (std::size_t k = 0; k < scan_items_per_work_item; ++k)
+							if (begin + k < size)
+								total += load(begin + k);
+						total = sycl::reduce_over_group(item.get_group(), total, sycl::plus<State>());
+						if (item.get_local_id(0) == 0)
+							block_offsets[item.get_group(0)] = total;
+						});
+				};
+				auto event = common::Submit(queue, reduce, dependencies);
+				event = BlockScan<State>(queue, blocks, BlockOffsetsLoad<State>{ block_offsets }, BlockOffsetsStore<State>{ block_offsets }, { event });
+				scan_dependencies = { event };
+			}
+
+			auto scan = [=](sycl::handler& h) {
+				h.parallel_for(range, [=](sycl::nd_item<1> item) {
+					const auto begin = item.get_global_id(0) * scan_items_per_work_item;
+					State values[scan_items_per_work_item];
+					State total = 0;
+					for (std::size_t k = 0; k < scan_items_per_work_item; ++k) {
+						values[k] = begin + k < size ? load(begin + k) : State(0);
+						total += values[k];
+					}
+
+					auto prefix = sycl::exclusive_scan_over_group(item.get_group(), total, sycl::plus<State>());
+					if (block_offsets)
+						prefix += block_offsets[item.get_group(0)];
+					for (std::size_t k = 0; k < scan_items_per_work_item && begin + k < size; ++k) {
+						store(begin + k, prefix, values[k]);
+						prefix += values[k];
+					}
+					});
+			};
+			auto event = common::Submit(queue, scan, scan_dependencies);
+			if (block_offsets)
+				common::ReleaseScratch(queue, block_offsets);
+			return event;
+		}
+
+		template <TypesToUse types_to_use>
+		struct CumSumOp {
+		protected:
+			using scan_types = enabled_data_types_t<eltwise_types_t<types_to_use>>;
+
+			template <typename T, typename U>
+			sycl::event Process(GALILEO_QUEUE queue, const T* input_ptr, U* output_ptr, const std::vector<sycl::event>& dependencies) const {
+				using State = accumulator_t<T>;
+				const auto is_inclusive = this->is_inclusive;
+				auto load = [=](std::size_t i) { return static_cast<State>(input_ptr[i]); };
+				auto store = [=](std::size_t i, State prefix, State value) { output_ptr[i] = static_cast<U>(is_inclusive ? prefix + value : prefix); };
+				return BlockScan<State>(queue, size, load, store, dependencies);
+			}
+
+		public:
+			using InputType = decltype(common::GetVariantFromTuple<true>(std::declval<variant_types_t<scan_types>>()));
+			using OutputType = decltype(common::GetVariantFromTuple<false>(std::declval<variant_types_t<scan_types>>()));
+
+			InputType input;
+			OutputType output;
+			std::size_t size;
+			bool is_inclusive;
+
+			// tensors are scanned in the row-major order of their elements
+			CumSumOp(const GALILEO_TENSOR& input, GALILEO_SCAN_MODE mode, GALILEO_TENSOR& output) :
+				input(GetVariantFromTypes<true, InputType, scan_types>(input.tensor_data, input.data_type)),
+				output(GetVariantFromTypes<false, OutputType, scan_types>(output.tensor_data, output.data_type)),
+				size(common::GetTotalSize(input.dimensions)),
+				is_inclusive(mode == GALILEO_SCAN_INCLUSIVE) {
+				if (mode != GALILEO_SCAN_INCLUSIVE && mode != GALILEO_SCAN_EXCLUSIVE)
+					throw GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+				if (size == 0 || size != common::GetTotalSize(output.dimensions) ||
+					!common::IsContiguous(input.dimensions) || !common::IsContiguous(output.dimensions))
+					throw GALILEO_RESULT::GALILEO_RESULT_TENSOR_DIMENSIONS_MISMATCH;
+			}
+
+			sycl::event Submit(GALILEO_QUEUE queue, const std::vector<sycl::event>& dependencies) const {
+				return std::visit([&](const auto* input_ptr, auto* output_ptr) { return Process(queue, input_ptr, output_ptr, dependencies); }, input, output);
+			}
+		};
+
+		// stream compaction: positions of the selected elements are the exclusive scan of the mask
+		template <TypesToUse types_to_use>
+		struct CompactOp {
+		protected:
+			using compact_types = enabled_data_types_t<eltwise_types_t<types_to_use>>;
+			using mask_types = eltwise_types_uintegers;
+
+			template <typename T, typename M>
+			sycl::event Process(GALILEO_QUEUE queue, const T* input_ptr, const M* mask_ptr, const std::vector<sycl::event>& dependencies) const {
+				using State = std::int64_t;
+				auto output_ptr = static_cast<T*>(output);
+				auto count_ptr = this->count;
+				const auto last = size - 1;
+				auto load = [=](std::size_t i) { return static_cast<State>(mask_ptr[i] != 0); };
+				auto store = [=](std::size_t i, State prefix, State value) {
+					if (value)
+						output_ptr[prefix] = input_ptr[i];
+					if (i == last)
+						*count_ptr = prefix + value;
+				};
+				return BlockScan<State>(queue, size, load, store, dependencies);
+			}
+
+		public:
+			using InputType = decltype(common::GetVariantFromTuple<true>(std::declval<variant_types_t<compact_types>>()));
+			using MaskType = decltype(common::GetVariantFromTuple<true>(std::declval<mask_types>()));
+
+			InputType input;
+			MaskType mask;
+			void* output;
+			std::int64_t* count;
+			std::size_t size;
+
+			// the output has the input data type and room for every element, the number of selected ones is written to count
+			CompactOp(const GALILEO_TENSOR& input, const GALILEO_TENSOR& mask, GALILEO_TENSOR& output, GALILEO_TENSOR& count) :
+				input(GetVariantFromTypes<true, InputType, compact_types>(input.tensor_data, input.data_type)),
+				mask(GetVariantFromTypes<true, MaskType, mask_types>(mask.tensor_data, mask.data_type)),
+				output(output.tensor_data),
+				count(static_cast<std::int64_t*>(count.tensor_data)),
+				size(common::GetTotalSize(input.dimensions)) {
+				if (output.data_type != input.data_type || count.data_type != GALILEO_INT64)
+					throw GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE;
+				if (size == 0 || size != common::GetTotalSize(mask.dimensions) || common::GetTotalSize(output.dimensions) < size ||
+					common::GetTotalSize(count.dimensions) == 0 || !common::IsContiguous(input.dimensions) ||
+					!common::IsContiguous(mask.dimensions) || !common::IsContiguous(output.dimensions))
+					throw GALILEO_RESULT::GALILEO_RESULT_TENSOR_DIMENSIONS_MISMATCH;
+			}
+
+			sycl::event Submit(GALILEO_QUEUE queue, const std::vector<sycl::event>& dependencies) const {
+				return std::visit([&](const auto* input_ptr, const auto* mask_ptr) { return Process(queue, input_ptr, mask_ptr, dependencies); }, input, mask);
+			}
+		};
+	}
+}
+
+using CumSum = galileo::CumSumOp < galileo::TypesToUse::FpWithIntegers > ;
+using Compact = galileo::CompactOp < galileo::TypesToUse::FpWithIntegers > ;
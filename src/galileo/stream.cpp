@@ -0,0 +1,254 @@
+#include "common.hpp"
+#include "context.hpp"
+#include "fusion.hpp"
+
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+	constexpr unsigned int default_chunk_elements = 1 << 20;
+	constexpr unsigned int default_queue_depth = 3;
+
+	// read-only view of an existing file, or a new file of the given size opened for writing
+	class MappedFile {
+		std::byte* data = nullptr;
+		std::size_t size = 0;
+#ifdef _WIN32
+		HANDLE file = INVALID_HANDLE_VALUE;
+		HANDLE mapping = nullptr;
+#endif
+
+	public:
+		MappedFile(const char* path, std::optional<std::size_t> write_size) {
+#ifdef _WIN32
+			file = CreateFileA(path, write_size ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ, nullptr, write_size ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file == INVALID_HANDLE_VALUE)
+				throw GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+			LARGE_INTEGER file_size{};
+			if (write_size)
+				file_size.QuadPart = static_cast<LONGLONG>(*write_size);
+			else
+				GetFileSizeEx(file, &file_size);
+			size = static_cast<std::size_t>(file_size.QuadPart);
+			if (!size)
+				return;
+			mapping = CreateFileMappingA(file, nullptr, write_size ? PAGE_READWRITE : PAGE_READONLY, file_size.HighPart, file_size.LowPart, nullptr);
+			if (!mapping)
+				throw GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+			data = static_cast<std::byte*>(MapViewOfFile(mapping, write_size ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size));
+#else
+			const auto file = open(path, write_size ? O_RDWR | O_CREAT | O_TRUNC : O_RDONLY, 0644);
+			if (file < 0)
+				throw GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+			struct stat file_stat {};
+			const auto is_sized = write_size ? ftruncate(file, static_cast<off_t>(*write_size)) == 0 : fstat(file, &file_stat) == 0;
+			size = write_size ? *write_size : static_cast<std::size_t>(file_stat.st_size);
+			if (is_sized && size) {
+				auto ptr = mmap(nullptr, size, write_size ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, file, 0);
+				data = ptr == MAP_FAILED ? nullptr : static_cast<std::byte*>(ptr);
+			}
+			// the mapping keeps the file referenced
+			close(file);
+			if (!is_sized)
+				throw GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+#endif
+			if (size && !data)
+				throw GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+#ifndef _WIN32
+			// chunks are read front to back
+			if (data && !write_size)
+				madvise(data, size, MADV_SEQUENTIAL);
+#endif
+		}
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		~MappedFile() {
+#ifdef _WIN32
+			if (data)
+				UnmapViewOfFile(data);
+			if (mapping)
+				CloseHandle(mapping);
+			if (file != INVALID_HANDLE_VALUE)
+				CloseHandle(file);
+#else
+			if (data)
+				munmap(data, size);
+#endif
+		}
+
+		std::byte* GetData() const {
+			return data;
+		}
+
+		std::size_t GetSize() const {
+			return size;
+		}
+	};
+
+	// buffers of one chunk in flight: host staging next to the file data and device memory the expression runs on
+	struct Slot {
+		std::vector<void*> input_staging;
+		std::vector<void*> inputs;
+		std::vector<void*> outputs;
+		std::vector<void*> output_staging;
+		// chunk whose results are on the way back, written out before the slot is reused
+		std::optional<std::uint64_t> chunk;
+		unsigned int chunk_size = 0;
+		sycl::event event;
+	};
+
+	class Stream {
+		GALILEO_QUEUE queue;
+		// rebound to the slot buffers for every chunk, the caller's expression keeps its own tensors
+		galileo::Expression expression;
+		std::vector<GALILEO_DATA_TYPE> input_types;
+		std::vector<GALILEO_DATA_TYPE> output_types;
+		std::vector<std::unique_ptr<MappedFile>> sources;
+		std::vector<std::unique_ptr<MappedFile>> sinks;
+		std::vector<Slot> slots;
+		unsigned int chunk_elements;
+		std::uint64_t size = 0;
+
+		void AllocateSlots(unsigned int queue_depth) {
+			auto& pool = galileo::common::GetQueueContext(queue).pool;
+			slots.resize(queue_depth);
+			for (auto& slot : slots) {
+				for (auto data_type : input_types) {
+					const auto bytes = chunk_elements * galileo::common::GetDataTypeSize(data_type);
+					slot.input_staging.push_back(pool.Allocate(bytes, GALILEO_ALLOCATION_HOST));
+					slot.inputs.push_back(pool.Allocate(bytes, GALILEO_ALLOCATION_DEVICE));
+				}
+				for (auto data_type : output_types) {
+					const auto bytes = chunk_elements * galileo::common::GetDataTypeSize(data_type);
+					slot.outputs.push_back(pool.Allocate(bytes, GALILEO_ALLOCATION_DEVICE));
+					slot.output_staging.push_back(pool.Allocate(bytes, GALILEO_ALLOCATION_HOST));
+				}
+			}
+		}
+
+		// waits for the chunk of the slot and copies its results to the sinks
+		void Drain(Slot& slot) {
+			if (!slot.chunk)
+				return;
+			slot.event.wait_and_throw();
+			for (std::size_t i = 0; i < sinks.size(); ++i) {
+				const auto element_size = galileo::common::GetDataTypeSize(output_types[i]);
+				std::memcpy(sinks[i]->GetData() + *slot.chunk * chunk_elements * element_size, slot.output_staging[i], slot.chunk_size * element_size);
+			}
+			slot.chunk.reset();
+		}
+
+		void Submit(Slot& slot, std::uint64_t chunk) {
+			const auto begin = chunk * chunk_elements;
+			slot.chunk = chunk;
+			slot.chunk_size = static_cast<unsigned int>(std::min<std::uint64_t>(chunk_elements, size - begin));
+
+			std::vector<sycl::event> copies;
+			for (std::size_t i = 0; i < sources.size(); ++i) {
+				const auto bytes = slot.chunk_size * galileo::common::GetDataTypeSize(input_types[i]);
+				std::memcpy(slot.input_staging[i], sources[i]->GetData() + begin * galileo::common::GetDataTypeSize(input_types[i]), bytes);
+				auto copy = [destination = slot.inputs[i], source = slot.input_staging[i], bytes](sycl::handler& h) { h.memcpy(destination, source, bytes); };
+				copies.push_back(galileo::common::Submit(queue, copy, {}));
+			}
+
+			// the expression is compiled for the first chunk, the others only swap its buffers
+			expression.Bind(slot.inputs, slot.outputs, slot.chunk_size);
+			const std::vector<sycl::event> evaluated = { expression.Evaluate(copies) };
+
+			copies.clear();
+			for (std::size_t i = 0; i < sinks.size(); ++i) {
+				const auto bytes = slot.chunk_size * galileo::common::GetDataTypeSize(output_types[i]);
+				auto copy = [destination = slot.output_staging[i], source = slot.outputs[i], bytes](sycl::handler& h) { h.memcpy(destination, source, bytes); };
+				copies.push_back(galileo::common::Submit(queue, copy, evaluated));
+			}
+			slot.event = galileo::common::SubmitBarrier(queue, copies);
+		}
+
+	public:
+		Stream(const galileo::Expression& expression, const char* const* input_paths, const char* const* output_paths, unsigned int chunk_elements) :
+			queue(expression.GetQueue()), expression(expression), input_types(expression.GetInputTypes()), output_types(expression.GetOutputTypes()), chunk_elements(chunk_elements) {
+			if (input_types.empty() || output_types.empty())
+				throw GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+			// every source holds the same number of elements, the sinks are created to match
+			for (std::size_t i = 0; i < input_types.size(); ++i) {
+				if (!input_paths[i])
+					throw GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+				sources.push_back(std::make_unique<MappedFile>(input_paths[i], std::nullopt));
+				const auto element_size = galileo::common::GetDataTypeSize(input_types[i]);
+				const auto source_size = sources.back()->GetSize();
+				if (source_size % element_size || (i && source_size / element_size != size))
+					throw GALILEO_RESULT::GALILEO_RESULT_TENSOR_DIMENSIONS_MISMATCH;
+				size = source_size / element_size;
+			}
+			for (std::size_t i = 0; i < output_types.size(); ++i) {
+				if (!output_paths[i])
+					throw GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+				sinks.push_back(std::make_unique<MappedFile>(output_paths[i], size * galileo::common::GetDataTypeSize(output_types[i])));
+			}
+		}
+
+		~Stream() {
+			// a failed run may leave commands using the buffers
+			galileo::common::GetQueue(queue).wait();
+			auto& pool = galileo::common::GetQueueContext(queue).pool;
+			for (auto& slot : slots)
+				for (auto* buffers : { &slot.input_staging, &slot.inputs, &slot.outputs, &slot.output_staging })
+					for (auto ptr : *buffers)
+						pool.Deallocate(ptr);
+		}
+
+		// chunk n is read into its slot while chunk n - 1 runs on the device and chunk n - depth + 1 is written out
+		void Run(unsigned int queue_depth) {
+			AllocateSlots(queue_depth);
+			const auto chunks = (size + chunk_elements - 1) / chunk_elements;
+			for (std::uint64_t chunk = 0; chunk < chunks; ++chunk) {
+				auto& slot = slots[chunk % slots.size()];
+				Drain(slot);
+				Submit(slot, chunk);
+			}
+			for (std::uint64_t chunk = chunks > slots.size() ? chunks - slots.size() : 0; chunk < chunks; ++chunk)
+				Drain(slots[chunk % slots.size()]);
+		}
+	};
+}
+
+// input_paths and output_paths hold a file per input node of the expression (in creation order) and per output
+// the input files are raw arrays of the input tensors' data types, the tensors given to the expression only pick the data types
+GALILEO_RESULT GALILEO_StreamExpression(GALILEO_EXPRESSION expression, const char* const* input_paths, const char* const* output_paths, const GALILEO_STREAM_PROPERTIES* properties) {
+	try {
+		if (!expression || !input_paths || !output_paths)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		const auto stream_properties = properties ? *properties : GALILEO_STREAM_PROPERTIES{};
+		const auto chunk_elements = stream_properties.chunk_elements ? stream_properties.chunk_elements : default_chunk_elements;
+		const auto queue_depth = stream_properties.queue_depth ? stream_properties.queue_depth : default_queue_depth;
+		auto& typed_expression = galileo::GetExpression(expression);
+		if (galileo::common::GetQueueContext(typed_expression.GetQueue()).capture)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		Stream stream(typed_expression, input_paths, output_paths, chunk_elements);
+		stream.Run(queue_depth);
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+	return GALILEO_RESULT::GALILEO_RESULT_OK;
+}
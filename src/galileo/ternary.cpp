@@ -0,0 +1,49 @@
+#include "common.hpp"
+#include "context.hpp"
+#include "ternary.hpp"
+
+#define TERNARY_ELTWISE_FUNCTION_DEF(EXT_NAME, ASYNC_EXT_NAME, KERNEL_NAME) GALILEO_RESULT ASYNC_EXT_NAME(const GALILEO_TENSOR* input_first, const GALILEO_TENSOR* input_second, const GALILEO_TENSOR* input_third, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event) { \
+	try { \
+		const auto profile_start = galileo::common::ProfileClock::now(); \
+		if (!input_first || !input_second || !input_third || !output || \
+			!input_first->tensor_data || !input_second->tensor_data || !input_third->tensor_data || !output->tensor_data) \
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER; \
+	 \
+		if (!galileo::common::VerifyQueryPtrs(*input_first, *input_second, *input_third, *output)) \
+			return GALILEO_RESULT::GALILEO_RESULT_TENSOR_QUEUE_MISMATCH; \
+	 \
+		if (!galileo::common::VerifyBroadcastDimensions({ input_first, input_second, input_third }, *output) || !galileo::common::IsWritable(output->dimensions)) \
+			return GALILEO_RESULT::GALILEO_RESULT_TENSOR_DIMENSIONS_MISMATCH; \
+	 \
+		auto queue = input_first->associated_queue; \
+	 \
+		const auto input_first_ptr_state = galileo::common::VerifyTensor(*input_first); \
+		const auto input_second_ptr_state = galileo::common::VerifyTensor(*input_second); \
+		const auto input_third_ptr_state = galileo::common::VerifyTensor(*input_third); \
+		const auto output_ptr_state = galileo::common::VerifyTensor(*output); \
+		if (!input_first_ptr_state || !input_second_ptr_state || !input_third_ptr_state || !output_ptr_state) \
+			return GALILEO_RESULT_NON_USM_POINTER; \
+	\
+		auto dependencies = galileo::common::GetEvents(wait_events, wait_events_size); \
+		auto make_kernel = [](GALILEO_TENSOR* tensors) { return KERNEL_NAME(tensors[0], tensors[1], tensors[2], tensors[3]); }; \
+		galileo::common::SetEvent(event, galileo::common::ProfileOp(queue, #KERNEL_NAME, profile_start, std::array{ *input_first, *input_second, *input_third, *output }, [&](const auto& op_tensors) { return galileo::common::SubmitElementwiseOp(queue, op_tensors, make_kernel, dependencies); })); \
+	} \
+	catch (GALILEO_RESULT res) { \
+		return res; \
+	} \
+	catch (...) { \
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR; \
+	} \
+	return GALILEO_RESULT::GALILEO_RESULT_OK; \
+} \
+GALILEO_RESULT EXT_NAME(const GALILEO_TENSOR* input_first, const GALILEO_TENSOR* input_second, const GALILEO_TENSOR* input_third, GALILEO_TENSOR* output) { \
+	return ASYNC_EXT_NAME(input_first, input_second, input_third, output, nullptr, 0, nullptr); \
+}
+#define CREATE_EXT_NAME( s ) GALILEO_ ## s
+#define CREATE_ASYNC_EXT_NAME( s ) GALILEO_ ## s ## Async
+#define TERNARY_ELTWISE_FUNCTION(NAME) TERNARY_ELTWISE_FUNCTION_DEF(CREATE_EXT_NAME(NAME), CREATE_ASYNC_EXT_NAME(NAME), NAME)
+
+TERNARY_ELTWISE_FUNCTION(Clamp)
+TERNARY_ELTWISE_FUNCTION(Fma)
+TERNARY_ELTWISE_FUNCTION(Lerp)
+TERNARY_ELTWISE_FUNCTION(Where)
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "common.hpp"
+#include "types.hpp"
+
+namespace galileo {
+	inline namespace detail {
+		// the kernel is built for the output data type alone, the operands are read through their runtime data types and promoted to it
+		// only lossless promotions are accepted (int8 bounds of an int32 Clamp, an int16 addend of a float Fma), so the output has to be the widest operand
+		// the first operand may come from its own type set instead (the mask of Where)
+		template <TypesToUse types_to_use, auto F, typename mask_types = void>
+		struct TernaryElementwiseOp {
+		protected:
+			using ternary_eltwise_types = enabled_data_types_t<eltwise_types_t<types_to_use>>;
+			static constexpr bool is_mask_first = !std::is_void_v<mask_types>;
+
+			template <typename D, typename Tuple> struct promotable_types;
+			template <typename D, typename ... Args> struct promotable_types<D, std::tuple<Args...>> {
+				using type = decltype(std::tuple_cat(std::declval<std::conditional_t<common::IsLosslessPromotion<Args, D>(), std::tuple<Args>, std::tuple<>>>()...));
+			};
+			template <typename D> using operand_types_t = typename promotable_types<D, ternary_eltwise_types>::type;
+			template <typename D> using first_types_t = std::conditional_t<is_mask_first, mask_types, operand_types_t<D>>;
+			template <typename D> using first_t = std::conditional_t<is_mask_first, bool, D>;
+
+			struct Operand {
+				const void* ptr;
+				GALILEO_DATA_TYPE data_type;
+			};
+
+			template <typename Tuple> struct OperandReader;
+			template <typename ... Args> struct OperandReader<std::tuple<Args...>> {
+				static bool Contains(GALILEO_DATA_TYPE data_type) { return ((data_type == data_type_v<Args>) || ...); }
+
+				// the data type is the same for every work-item, so the branch doesn't diverge
+				template <typename To>
+				static To Read(Operand operand, std::size_t offset) {
+					To value{};
+					((operand.data_type == data_type_v<Args> && (value = common::Convert<To>(static_cast<const Args*>(operand.ptr)[offset]), true)) || ...);
+					return value;
+				}
+			};
+
+			template <typename T>
+			static common::compute_t<T> Compute(T value) { return static_cast<common::compute_t<T>>(value); }
+
+			template <typename D>
+			void Process(sycl::handler& h, D* output_ptr) {
+				using first_reader = OperandReader<first_types_t<D>>;
+				using operand_reader = OperandReader<operand_types_t<D>>;
+				auto input_first = this->input_first;
+				auto input_second = this->input_second;
+				auto input_third = this->input_third;
+
+				if (is_contiguous) {
+					h.parallel_for(size, [=](auto i) {
+						output_ptr[i] = static_cast<D>(F(Compute(first_reader::template Read<first_t<D>>(input_first, i)),
+							Compute(operand_reader::template Read<D>(input_second, i)), Compute(operand_reader::template Read<D>(input_third, i))));
+						});
+					return;
+				}
+
+				auto indexer = this->indexer;
+				h.parallel_for(size, [=](sycl::id<1> i) {
+					const auto [first_offset, second_offset, third_offset, output_offset] = indexer.GetOffsets(i[0]);
+					output_ptr[output_offset] = static_cast<D>(F(Compute(first_reader::template Read<first_t<D>>(input_first, first_offset)),
+						Compute(operand_reader::template Read<D>(input_second, second_offset)), Compute(operand_reader::template Read<D>(input_third, third_offset))));
+					});
+			}
+
+		public:
+			static constexpr auto function = F;
+
+			using OutputType = decltype(common::GetVariantFromTuple<false>(std::declval<variant_types_t<ternary_eltwise_types>>()));
+
+			Operand input_first;
+			Operand input_second;
+			Operand input_third;
+			OutputType output;
+			unsigned int size;
+			bool is_contiguous;
+			common::StridedIndexer<4> indexer;
+
+			TernaryElementwiseOp(const GALILEO_TENSOR& input_first, const GALILEO_TENSOR& input_second, const GALILEO_TENSOR& input_third, GALILEO_TENSOR& output) :
+				input_first{ input_first.tensor_data, input_first.data_type },
+				input_second{ input_second.tensor_data, input_second.data_type },
+				input_third{ input_third.tensor_data, input_third.data_type },
+				output(GetVariantFromTypes<false, OutputType, ternary_eltwise_types>(output.tensor_data, output.data_type)),
+				size(common::GetTotalSize(output.dimensions)),
+				is_contiguous(common::VerifyDimensionsPtrs(input_first, input_second, input_third, output) &&
+					common::IsContiguous(input_first.dimensions) && common::IsContiguous(input_second.dimensions) &&
+					common::IsContiguous(input_third.dimensions) && common::IsContiguous(output.dimensions)),
+				indexer(output.dimensions, { &input_first.dimensions, &input_second.dimensions, &input_third.dimensions, &output.dimensions }) {
+				const auto is_promotable = std::visit([&]<typename D>(D*) {
+					return OperandReader<first_types_t<D>>::Contains(input_first.data_type) &&
+						OperandReader<operand_types_t<D>>::Contains(input_second.data_type) && OperandReader<operand_types_t<D>>::Contains(input_third.data_type);
+				}, this->output);
+				const auto is_widest = input_second.data_type == output.data_type || input_third.data_type == output.data_type ||
+					(!is_mask_first && input_first.data_type == output.data_type);
+				if (!is_promotable || !is_widest)
+					throw GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE;
+			}
+
+			void operator()(sycl::handler& h) {
+				std::visit([&](auto* output_ptr) { Process(h, output_ptr); }, output);
+			}
+		};
+	}
+}
+
+using Fma = galileo::TernaryElementwiseOp < galileo::TypesToUse::OnlyFp, [](auto a, auto b, auto c) { return sycl::fma(a, b, c); } > ;
+using Clamp = galileo::TernaryElementwiseOp < galileo::TypesToUse::FpWithIntegers, [](auto v, auto lo, auto hi) { return sycl::clamp(v, lo, hi); } > ;
+using Lerp = galileo::TernaryElementwiseOp < galileo::TypesToUse::OnlyFp, [](auto a, auto b, auto t) { return sycl::mix(a, b, t); } > ;
+using Where = galileo::TernaryElementwiseOp < galileo::TypesToUse::FpWithIntegersAndComplex, [](auto mask, auto x, auto y) { return mask ? x : y; }, galileo::eltwise_types_uintegers > ;
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "common.hpp"
+
+namespace galileo {
+	inline namespace detail {
+		enum class TypesToUse {
+			OnlyFp,
+			FpWithSignedIntegers,
+			FpWithIntegers,
+			OnlyComplexFp,
+			FpWithIntegersAndComplex
+		};
+
+		using eltwise_types_integers = std::tuple<
+			std::int8_t,
+			std::int16_t,
+			std::int32_t,
+			std::int64_t
+		>;
+		using eltwise_types_uintegers = std::tuple<
+			std::uint8_t,
+			std::uint16_t,
+			std::uint32_t,
+			std::uint64_t
+		>;
+		using eltwise_types_fp = std::tuple<
+			float,
+			double,
+			sycl::half,
+			common::bfloat16
+		>;
+		using eltwise_types_complex_fp = std::tuple<
+			common::complex<float>,
+			common::complex<double>,
+			common::complex<sycl::half>
+		>;
+
+		using eltwise_types_with_signed_integers = decltype(std::tuple_cat(std::declval<eltwise_types_fp>(), std::declval<eltwise_types_integers>()));
+		using eltwise_types_with_integers = decltype(std::tuple_cat(std::declval<eltwise_types_with_signed_integers>(), std::declval<eltwise_types_uintegers>()));
+		using eltwise_types_with_integers_and_complex = decltype(std::tuple_cat(std::declval<eltwise_types_with_integers>(), std::declval<eltwise_types_complex_fp>()));
+
+		using eltwise_type_map = mk::TypeMap<
+			mk::ValueTypePair<TypesToUse::OnlyFp, eltwise_types_fp>,
+			mk::ValueTypePair<TypesToUse::FpWithSignedIntegers, eltwise_types_with_signed_integers>,
+			mk::ValueTypePair<TypesToUse::FpWithIntegers, eltwise_types_with_integers>,
+			mk::ValueTypePair<TypesToUse::OnlyComplexFp, eltwise_types_complex_fp>,
+			mk::ValueTypePair<TypesToUse::FpWithIntegersAndComplex, eltwise_types_with_integers_and_complex>
+		>;
+
+		template <TypesToUse types_to_use>
+		using eltwise_types_t = eltwise_type_map::GetTypeByValue<types_to_use>;
+
+		template <typename T> struct data_type;
+		template <> struct data_type<std::uint8_t> : std::integral_constant<GALILEO_DATA_TYPE, GALILEO_UINT8> {};
+		template <> struct data_type<std::uint16_t> : std::integral_constant<GALILEO_DATA_TYPE, GALILEO_UINT16> {};
+		template <> struct data_type<std::uint32_t> : std::integral_constant<GALILEO_DATA_TYPE, GALILEO_UINT32> {};
+		template <> struct data_type<std::uint64_t> : std::integral_constant<GALILEO_DATA_TYPE, GALILEO_UINT64> {};
+		template <> struct data_type<std::int8_t> : std::integral_constant<GALILEO_DATA_TYPE, GALILEO_INT8> {};
+		template <> struct data_type<std::int16_t> : std::integral_constant<GALILEO_DATA_TYPE, GALILEO_INT16> {};
+		template <> struct data_type<std::int32_t> : std::integral_constant<GALILEO_DATA_TYPE, GALILEO_INT32> {};
+		template <> struct data_type<std::int64_t> : std::integral_constant<GALILEO_DATA_TYPE, GALILEO_INT64> {};
+		template <> struct data_type<float> : std::integral_constant<GALILEO_DATA_TYPE, GALILEO_FLOAT> {};
+		template <> struct data_type<double> : std::integral_constant<GALILEO_DATA_TYPE, GALILEO_DOUBLE> {};
+		template <> struct data_type<sycl::half> : std::integral_constant<GALILEO_DATA_TYPE, GALILEO_HALF> {};
+		template <> struct data_type<common::complex<float>> : std::integral_constant<GALILEO_DATA_TYPE, GALILEO_COMPLEX_FLOAT> {};
+		template <> struct data_type<common::complex<double>> : std::integral_constant<GALILEO_DATA_TYPE, GALILEO_COMPLEX_DOUBLE> {};
+		template <> struct data_type<common::complex<sycl::half>> : std::integral_constant<GALILEO_DATA_TYPE, GALILEO_COMPLEX_HALF> {};
+		template <> struct data_type<common::bfloat16> : std::integral_constant<GALILEO_DATA_TYPE, GALILEO_BFLOAT16> {};
+		template <typename T> constexpr GALILEO_DATA_TYPE data_type_v = data_type<T>::value;
+
+		// GALILEO_TYPES and GALILEO_OPS of the build (see src/CMakeLists.txt) limit the instantiated kernels, everything is built without them
+		constexpr bool IsEnabledDataType(GALILEO_DATA_TYPE data_type) {
+#ifdef GALILEO_ENABLED_TYPES
+			for (auto enabled_type : { GALILEO_ENABLED_TYPES })
+				if (enabled_type == data_type)
+					return true;
+			return false;
+#else
+			return true;
+#endif
+		}
+
+		constexpr bool IsEnabledOp(GALILEO_OP op) {
+#ifdef GALILEO_ENABLED_OPS
+			for (auto enabled_op : { GALILEO_ENABLED_OPS })
+				if (enabled_op == op)
+					return true;
+			return false;
+#else
+			return true;
+#endif
+		}
+
+		// kernel families without a GALILEO_OP (ternary, cast, reductions, scans) are limited by GALILEO_TYPES alone
+		template <typename Tuple> struct enabled_data_types;
+		template <typename ... Args> struct enabled_data_types<std::tuple<Args...>> {
+			using type = decltype(std::tuple_cat(std::declval<std::conditional_t<IsEnabledDataType(data_type_v<Args>), std::tuple<Args>, std::tuple<>>>()...));
+		};
+		template <typename Tuple> using enabled_data_types_t = typename enabled_data_types<Tuple>::type;
+
+		template <GALILEO_OP op, typename Tuple> using enabled_types_t = std::conditional_t<IsEnabledOp(op), enabled_data_types_t<Tuple>, std::tuple<>>;
+
+		// a variant needs an alternative, an op left without types keeps a placeholder that is rejected before any kernel is built
+		template <typename Tuple> struct variant_types { using type = Tuple; };
+		template <> struct variant_types<std::tuple<>> { using type = std::tuple<float>; };
+		template <typename Tuple> using variant_types_t = typename variant_types<Tuple>::type;
+
+		// half, bfloat16 and narrow integers are accumulated in 32 bits
+		template <typename T> struct accumulator { using type = T; };
+		template <> struct accumulator<sycl::half> { using type = float; };
+		template <> struct accumulator<common::bfloat16> { using type = float; };
+		template <> struct accumulator<std::int8_t> { using type = std::int32_t; };
+		template <> struct accumulator<std::int16_t> { using type = std::int32_t; };
+		template <> struct accumulator<std::uint8_t> { using type = std::uint32_t; };
+		template <> struct accumulator<std::uint16_t> { using type = std::uint32_t; };
+		template <typename T> using accumulator_t = typename accumulator<T>::type;
+
+		// pointer alternative of the variant for the runtime data type, types outside of the set are rejected
+		template <bool is_const, typename Variant, typename Types>
+		Variant GetVariantFromTypes(CONSTIFY(void)* ptr, GALILEO_DATA_TYPE data_type) {
+			auto get_alternative = [ptr]<typename T>(T*) -> Variant {
+				if constexpr (common::tuple_contains_v<T, Types>)
+					return reinterpret_cast<CONSTIFY(T)*>(ptr);
+				else
+					throw GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE;
+			};
+
+			switch (data_type) {
+			case GALILEO_UINT8: return get_alternative(static_cast<std::uint8_t*>(nullptr));
+			case GALILEO_UINT16: return get_alternative(static_cast<std::uint16_t*>(nullptr));
+			case GALILEO_UINT32: return get_alternative(static_cast<std::uint32_t*>(nullptr));
+			case GALILEO_UINT64: return get_alternative(static_cast<std::uint64_t*>(nullptr));
+			case GALILEO_INT8: return get_alternative(static_cast<std::int8_t*>(nullptr));
+			case GALILEO_INT16: return get_alternative(static_cast<std::int16_t*>(nullptr));
+			case GALILEO_INT32: return get_alternative(static_cast<std::int32_t*>(nullptr));
+			case GALILEO_INT64: return get_alternative(static_cast<std::int64_t*>(nullptr));
+			case GALILEO_FLOAT: return get_alternative(static_cast<float*>(nullptr));
+			case GALILEO_DOUBLE: return get_alternative(static_cast<double*>(nullptr));
+			case GALILEO_HALF: return get_alternative(static_cast<sycl::half*>(nullptr));
+			case GALILEO_COMPLEX_FLOAT: return get_alternative(static_cast<common::complex<float>*>(nullptr));
+			case GALILEO_COMPLEX_DOUBLE: return get_alternative(static_cast<common::complex<double>*>(nullptr));
+			case GALILEO_COMPLEX_HALF: return get_alternative(static_cast<common::complex<sycl::half>*>(nullptr));
+			case GALILEO_BFLOAT16: return get_alternative(static_cast<common::bfloat16*>(nullptr));
+			default:
+				throw GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE;
+			}
+		}
+	}
+}
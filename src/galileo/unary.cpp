@@ -1,43 +1,45 @@
 #include "common.hpp"
+#include "context.hpp"
 #include "unary.hpp"
 #include <variant>
 
-#define UNARY_ELTWISE_FUNCTION_DEF(EXT_NAME, KERNEL_NAME) GALILEO_RESULT EXT_NAME(const GALILEO_TENSOR* input, GALILEO_TENSOR* output) { \
+#define UNARY_ELTWISE_FUNCTION_DEF(EXT_NAME, ASYNC_EXT_NAME, KERNEL_NAME) GALILEO_RESULT ASYNC_EXT_NAME(const GALILEO_TENSOR* input, GALILEO_TENSOR* output, const GALILEO_EVENT* wait_events, unsigned int wait_events_size, GALILEO_EVENT* event) { \
 	try { \
+		const auto profile_start = galileo::common::ProfileClock::now(); \
 		if (!input || !output || !input->tensor_data || !output->tensor_data) \
 			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER; \
 	 \
 		if (!galileo::common::VerifyQueryPtrs(*input, *output)) \
 			return GALILEO_RESULT::GALILEO_RESULT_TENSOR_QUEUE_MISMATCH; \
 	 \
-		if (!galileo::common::VerifyDimensionsPtrs(*input, *output)) \
+		if (!galileo::common::VerifyDimensionsPtrs(*input, *output) || !galileo::common::IsWritable(output->dimensions)) \
 			return GALILEO_RESULT::GALILEO_RESULT_TENSOR_DIMENSIONS_MISMATCH; \
 	 \
 		auto queue = input->associated_queue; \
 	 \
-		const auto input_ptr_state = galileo::common::VerifyPtr(galileo::common::GetQueue(queue), input->tensor_data); \
-		const auto output_ptr_state = galileo::common::VerifyPtr(galileo::common::GetQueue(queue), output->tensor_data); \
+		const auto input_ptr_state = galileo::common::VerifyTensor(*input); \
+		const auto output_ptr_state = galileo::common::VerifyTensor(*output); \
 		if (!input_ptr_state || !output_ptr_state) \
 			return GALILEO_RESULT_NON_USM_POINTER; \
 	\
-		auto kernel = KERNEL_NAME(*input, *output); \
-		auto& typed_queue = galileo::common::GetQueue(queue); \
-		typed_queue.submit(kernel); \
+		auto dependencies = galileo::common::GetEvents(wait_events, wait_events_size); \
+		auto make_kernel = [](GALILEO_TENSOR* tensors) { return KERNEL_NAME(tensors[0], tensors[1]); }; \
+		galileo::common::SetEvent(event, galileo::common::ProfileOp(queue, #KERNEL_NAME, profile_start, std::array{ *input, *output }, [&](const auto& op_tensors) { return galileo::common::SubmitElementwiseOp(queue, op_tensors, make_kernel, dependencies); })); \
 	} \
 	catch (GALILEO_RESULT res) { \
 		return res; \
 	} \
-	catch (std::exception& e) { \
-		std::cerr << e.what() << std::endl; \
-		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR; \
-	} \
 	catch (...) { \
 		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR; \
 	} \
 	return GALILEO_RESULT::GALILEO_RESULT_OK; \
+} \
+GALILEO_RESULT EXT_NAME(const GALILEO_TENSOR* input, GALILEO_TENSOR* output) { \
+	return ASYNC_EXT_NAME(input, output, nullptr, 0, nullptr); \
 }
 #define CREATE_EXT_NAME( s ) GALILEO_ ## s
-#define UNARY_ELTWISE_FUNCTION(NAME) UNARY_ELTWISE_FUNCTION_DEF(CREATE_EXT_NAME(NAME), NAME)
+#define CREATE_ASYNC_EXT_NAME( s ) GALILEO_ ## s ## Async
+#define UNARY_ELTWISE_FUNCTION(NAME) UNARY_ELTWISE_FUNCTION_DEF(CREATE_EXT_NAME(NAME), CREATE_ASYNC_EXT_NAME(NAME), NAME)
 
 UNARY_ELTWISE_FUNCTION(Abs)
 UNARY_ELTWISE_FUNCTION(Acos)
@@ -1,148 +1,166 @@
+#pragma once
+
 #include "common.hpp"
+#include "types.hpp"
 
 namespace galileo {
 	inline namespace detail {
-		enum class TypesToUse {
-			OnlyFp,
-			FpWithSignedIntegers,
-			FpWithIntegers,
-			OnlyComplexFp,
-			FpWithIntegersAndComplex
-		};
-
-		template <TypesToUse types_to_use, auto F>
+		template <GALILEO_OP op, TypesToUse types_to_use, auto F>
 		struct UnaryElementwiseOp {
 		protected:
-			using eltwise_types_integers = std::tuple<
-				std::int8_t,
-				std::int16_t,
-				std::int32_t,
-				std::int64_t
-			>;
-			using eltwise_types_uintegers = std::tuple<
-				std::uint8_t,
-				std::uint16_t,
-				std::uint32_t,
-				std::uint64_t
-			>;
-			using eltwise_types_fp = std::tuple<
-				float,
-				double,
-				sycl::half
-			>;
-			using eltwise_types_complex_fp = std::tuple<
-				common::complex<float>,
-				common::complex<double>,
-				common::complex<sycl::half>
-			>;
-
-			using eltwise_types_with_signed_integers = decltype(std::tuple_cat(std::declval<eltwise_types_fp>(), std::declval<eltwise_types_integers>()));
-			using eltwise_types_with_integers = decltype(std::tuple_cat(std::declval<eltwise_types_with_signed_integers>(), std::declval<eltwise_types_uintegers>()));
-			using eltwise_types_with_integers_and_complex = decltype(std::tuple_cat(std::declval<eltwise_types_with_integers>(), std::declval<eltwise_types_complex_fp>()));
-
-			using type_map = mk::TypeMap<
-				mk::ValueTypePair<TypesToUse::OnlyFp, eltwise_types_fp>,
-				mk::ValueTypePair<TypesToUse::FpWithSignedIntegers, eltwise_types_with_signed_integers>,
-				mk::ValueTypePair<TypesToUse::FpWithIntegers, eltwise_types_with_integers>,
-				mk::ValueTypePair<TypesToUse::OnlyComplexFp, eltwise_types_complex_fp>,
-				mk::ValueTypePair<TypesToUse::FpWithIntegersAndComplex, eltwise_types_with_integers_and_complex>
-			>;
-
-			using eltwise_types = type_map::GetTypeByValue<types_to_use>;
+			using eltwise_types = enabled_types_t<op, eltwise_types_t<types_to_use>>;
 
 			template <bool is_const, typename T>
 			static T GetVariantFromInput(CONSTIFY(void)* ptr, GALILEO_DATA_TYPE data_type) {
-				if constexpr (types_to_use == TypesToUse::FpWithIntegers) {
-					switch (data_type) {
-					case GALILEO_UINT8: return reinterpret_cast<CONSTIFY(std::uint8_t)*>(ptr);
-					case GALILEO_UINT16: return reinterpret_cast<CONSTIFY(std::uint16_t)*>(ptr);
-					case GALILEO_UINT32: return reinterpret_cast<CONSTIFY(std::uint32_t)*>(ptr);
-					case GALILEO_UINT64: return reinterpret_cast<CONSTIFY(std::uint64_t)*>(ptr);
-					default:
-						break;
+				return GetVariantFromTypes<is_const, T, eltwise_types>(ptr, data_type);
+			}
+
+			template <typename T, typename U>
+			void ProcessVectorized(sycl::handler& h, const T* input_ptr, U* output_ptr) {
+				constexpr auto width = common::vector_width<T, U>;
+				const std::size_t size = this->size;
+				const auto chunks = size / width;
+				h.parallel_for(common::GetVectorizedRange(chunks, size % width != 0), [=](sycl::nd_item<1> item) {
+					const auto chunk = item.get_global_id(0);
+					if (chunk < chunks) {
+						sycl::vec<T, width> src;
+						sycl::vec<U, width> dst;
+						src.load(chunk, common::GetGlobalPtr(input_ptr));
+						for (int k = 0; k < width; ++k)
+							dst[k] = static_cast<U>(F(static_cast<T>(src[k])));
+						dst.store(chunk, common::GetGlobalPtr(output_ptr));
 					}
-				}
-				if constexpr (types_to_use == TypesToUse::FpWithSignedIntegers) {
-					switch (data_type) {
-					case GALILEO_INT8: return reinterpret_cast<CONSTIFY(std::int8_t)*>(ptr);
-					case GALILEO_INT16: return reinterpret_cast<CONSTIFY(std::int16_t)*>(ptr);
-					case GALILEO_INT32: return reinterpret_cast<CONSTIFY(std::int32_t)*>(ptr);
-					case GALILEO_INT64: return reinterpret_cast<CONSTIFY(std::int64_t)*>(ptr);
-					default:
-						break;
+					else if (chunk == chunks) {
+						for (auto i = chunks * width; i < size; ++i)
+							output_ptr[i] = static_cast<U>(F(input_ptr[i]));
 					}
-				}
-				if constexpr (types_to_use != TypesToUse::OnlyComplexFp) {
-					switch (data_type) {
-					case GALILEO_FLOAT: return reinterpret_cast<CONSTIFY(float)*>(ptr);
-					case GALILEO_DOUBLE: return reinterpret_cast<CONSTIFY(double)*>(ptr);
-					case GALILEO_HALF: return reinterpret_cast<CONSTIFY(sycl::half)*>(ptr);
-					default:
-						break;
+					});
+			}
+
+			template <typename T, typename U>
+			void Process(sycl::handler& h, const T* input_ptr, U* output_ptr) {
+				if constexpr (!is_supported_type<T> || !is_supported_type<U>)
+					throw GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE;
+				else {
+					if constexpr (common::vector_width<T, U> > 1) {
+						if (is_contiguous && common::IsVectorAligned<common::vector_width<T, U>>(input_ptr, output_ptr)) {
+							ProcessVectorized(h, input_ptr, output_ptr);
+							return;
+						}
 					}
-				}
-				if constexpr (types_to_use == TypesToUse::OnlyComplexFp) {
-					switch (data_type) {
-					case GALILEO_COMPLEX_FLOAT: return reinterpret_cast<CONSTIFY(common::complex<float>)*>(ptr);
-					case GALILEO_COMPLEX_DOUBLE: return reinterpret_cast<CONSTIFY(common::complex<double>)*>(ptr);
-					case GALILEO_COMPLEX_HALF: return reinterpret_cast<CONSTIFY(common::complex<sycl::half>)*>(ptr);
-					default:
-						break;
+
+					if (is_contiguous) {
+						h.parallel_for(size, [=](auto i) {
+							output_ptr[i] = Apply<T, U>(input_ptr[i]);
+							});
+						return;
 					}
-				}
-				switch (data_type) {
-				default:
-					throw GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE;
+
+					auto indexer = this->indexer;
+					h.parallel_for(size, [=](sycl::id<1> i) {
+						const auto [input_offset, output_offset] = indexer.GetOffsets(i[0]);
+						output_ptr[output_offset] = Apply<T, U>(input_ptr[input_offset]);
+						});
 				}
 			}
 
+		public:
+			static constexpr auto function = F;
+			template <typename T>
+			static constexpr bool is_supported_type = common::tuple_contains_v<T, eltwise_types>;
+
+			// single element, shared with the multi-tensor launch
 			template <typename T, typename U>
-			void Process(sycl::handler& h, const T* input_ptr, U* output_ptr) {
-				h.parallel_for(size, [=](auto i) {
-					auto src = input_ptr[i];
-					auto dst = F(src);
-					output_ptr[i] = static_cast<U>(dst);
-					});
+			static U Apply(T value) {
+				return static_cast<U>(F(static_cast<common::compute_t<T>>(value)));
 			}
 
-		public:
-			using InputType = decltype(common::GetVariantFromTuple<true>(std::declval<eltwise_types>()));
-			using OutputType = decltype(common::GetVariantFromTuple<false>(std::declval<eltwise_types>()));
+			using InputType = decltype(common::GetVariantFromTuple<true>(std::declval<variant_types_t<eltwise_types>>()));
+			using OutputType = decltype(common::GetVariantFromTuple<false>(std::declval<variant_types_t<eltwise_types>>()));
 
 			InputType input;
 			OutputType output;
 			unsigned int size;
+			bool is_contiguous;
+			common::StridedIndexer<2> indexer;
 
 			UnaryElementwiseOp(const GALILEO_TENSOR& input, GALILEO_TENSOR& output) :
 				input(GetVariantFromInput<true, InputType>(input.tensor_data, input.data_type)),
 				output(GetVariantFromInput<false, OutputType>(output.tensor_data, output.data_type)),
-				size(common::GetTotalSize(input.dimensions)) {}
+				size(common::GetTotalSize(input.dimensions)),
+				is_contiguous(common::IsContiguous(input.dimensions) && common::IsContiguous(output.dimensions)),
+				indexer(output.dimensions, { &input.dimensions, &output.dimensions }) {}
 
 			void operator()(sycl::handler& h) {
 				std::visit([&](const auto* input_ptr, auto* output_ptr) { Process(h, input_ptr, output_ptr); }, input, output);
 			}
+
+			// typed entry point for prebound plans, the alternatives are resolved once when the plan is created
+			template <typename T, typename U>
+			void Launch(sycl::handler& h) {
+				Process(h, std::get<const T*>(input), std::get<U*>(output));
+			}
+
+			// the same element function as a plain loop on the calling thread, used for small tensors of CPU queues
+			void RunOnHost() {
+				std::visit([&]<typename T, typename U>(const T* input_ptr, U* output_ptr) {
+					if constexpr (!is_supported_type<T> || !is_supported_type<U>)
+						throw GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE;
+					else if (is_contiguous) {
+						for (unsigned int i = 0; i < size; ++i)
+							output_ptr[i] = Apply<T, U>(input_ptr[i]);
+					}
+					else {
+						for (unsigned int i = 0; i < size; ++i) {
+							const auto [input_offset, output_offset] = indexer.GetOffsets(i);
+							output_ptr[output_offset] = Apply<T, U>(input_ptr[input_offset]);
+						}
+					}
+					}, input, output);
+			}
 		};
 	}
 }
 
-using Abs = galileo::UnaryElementwiseOp < galileo::TypesToUse::FpWithIntegers, [](auto v) { return sycl::abs(v); } > ;
-using Acos = galileo::UnaryElementwiseOp < galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::acos(v); } > ;
-using Acosh = galileo::UnaryElementwiseOp < galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::acosh(v); } > ;
-using Asin = galileo::UnaryElementwiseOp < galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::asin(v); } > ;
-using Asinh = galileo::UnaryElementwiseOp < galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::asinh(v); } > ;
-using Atan = galileo::UnaryElementwiseOp < galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::atan(v); } > ;
-using Atanh = galileo::UnaryElementwiseOp < galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::atanh(v); } > ;
-using Conj = galileo::UnaryElementwiseOp < galileo::TypesToUse::OnlyComplexFp, [](auto v) { return sycl::ext::oneapi::experimental::conj(v); } > ;
-using Cos = galileo::UnaryElementwiseOp < galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::cos(v); } > ;
-using Cosh = galileo::UnaryElementwiseOp < galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::cosh(v); } > ;
-using Erf = galileo::UnaryElementwiseOp < galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::erf(v); } > ;
-using Exp = galileo::UnaryElementwiseOp < galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::exp(v); } > ;
-using Log = galileo::UnaryElementwiseOp < galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::log(v); } > ;
-using Neg = galileo::UnaryElementwiseOp < galileo::TypesToUse::FpWithSignedIntegers, [](auto v) { return -v; } > ;
-using Sign = galileo::UnaryElementwiseOp < galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::sign(v); } > ;
-using Sin = galileo::UnaryElementwiseOp < galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::sin(v); } > ;
-using Sinh = galileo::UnaryElementwiseOp < galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::sinh(v); } > ;
-using Sqrt = galileo::UnaryElementwiseOp < galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::sqrt(v); } > ;
-using Tan = galileo::UnaryElementwiseOp < galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::tan(v); } > ;
-using Tanh = galileo::UnaryElementwiseOp <galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::tanh(v); } > ;
+using Abs = galileo::UnaryElementwiseOp < GALILEO_OP_ABS, galileo::TypesToUse::FpWithIntegers, [](auto v) { return sycl::abs(v); } > ;
+using Acos = galileo::UnaryElementwiseOp < GALILEO_OP_ACOS, galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::acos(v); } > ;
+using Acosh = galileo::UnaryElementwiseOp < GALILEO_OP_ACOSH, galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::acosh(v); } > ;
+using Asin = galileo::UnaryElementwiseOp < GALILEO_OP_ASIN, galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::asin(v); } > ;
+using Asinh = galileo::UnaryElementwiseOp < GALILEO_OP_ASINH, galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::asinh(v); } > ;
+using Atan = galileo::UnaryElementwiseOp < GALILEO_OP_ATAN, galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::atan(v); } > ;
+using Atanh = galileo::UnaryElementwiseOp < GALILEO_OP_ATANH, galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::atanh(v); } > ;
+using Conj = galileo::UnaryElementwiseOp < GALILEO_OP_CONJ, galileo::TypesToUse::OnlyComplexFp, [](auto v) { return sycl::ext::oneapi::experimental::conj(v); } > ;
+using Cos = galileo::UnaryElementwiseOp < GALILEO_OP_COS, galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::cos(v); } > ;
+using Cosh = galileo::UnaryElementwiseOp < GALILEO_OP_COSH, galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::cosh(v); } > ;
+using Erf = galileo::UnaryElementwiseOp < GALILEO_OP_ERF, galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::erf(v); } > ;
+using Exp = galileo::UnaryElementwiseOp < GALILEO_OP_EXP, galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::exp(v); } > ;
+using Log = galileo::UnaryElementwiseOp < GALILEO_OP_LOG, galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::log(v); } > ;
+using Neg = galileo::UnaryElementwiseOp < GALILEO_OP_NEG, galileo::TypesToUse::FpWithSignedIntegers, [](auto v) { return -v; } > ;
+using Sign = galileo::UnaryElementwiseOp < GALILEO_OP_SIGN, galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::sign(v); } > ;
+using Sin = galileo::UnaryElementwiseOp < GALILEO_OP_SIN, galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::sin(v); } > ;
+using Sinh = galileo::UnaryElementwiseOp < GALILEO_OP_SINH, galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::sinh(v); } > ;
+using Sqrt = galileo::UnaryElementwiseOp < GALILEO_OP_SQRT, galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::sqrt(v); } > ;
+using Tan = galileo::UnaryElementwiseOp < GALILEO_OP_TAN, galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::tan(v); } > ;
+using Tanh = galileo::UnaryElementwiseOp < GALILEO_OP_TANH, galileo::TypesToUse::OnlyFp, [](auto v) { return sycl::tanh(v); } > ;
 
+#define GALILEO_UNARY_OPS(X) \
+	X(Abs, ABS) \
+	X(Acos, ACOS) \
+	X(Acosh, ACOSH) \
+	X(Asin, ASIN) \
+	X(Asinh, ASINH) \
+	X(Atan, ATAN) \
+	X(Atanh, ATANH) \
+	X(Conj, CONJ) \
+	X(Cos, COS) \
+	X(Cosh, COSH) \
+	X(Erf, ERF) \
+	X(Exp, EXP) \
+	X(Log, LOG) \
+	X(Neg, NEG) \
+	X(Sign, SIGN) \
+	X(Sin, SIN) \
+	X(Sinh, SINH) \
+	X(Sqrt, SQRT) \
+	X(Tan, TAN) \
+	X(Tanh, TANH)
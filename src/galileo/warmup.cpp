@@ -0,0 +1,126 @@
+#include "common.hpp"
+#include "context.hpp"
+#include "unary.hpp"
+#include "binary.hpp"
+
+#include <chrono>
+
+#define WARMUP_UNARY_OP(NAME, OP) if (op_mask & (1ull << GALILEO_OP_ ## OP)) WarmupOp<NAME, 1>(queue, block, type_mask, statistics, dependencies);
+#define WARMUP_BINARY_OP(NAME, OP) if (op_mask & (1ull << GALILEO_OP_ ## OP)) WarmupOp<NAME, 2>(queue, block, type_mask, statistics, dependencies);
+
+namespace {
+	// large enough and aligned for a vector of any data type, so that the warmed up kernels are the vectorized ones used by contiguous tensors
+	constexpr std::size_t warmup_block_size = 256;
+	// the inputs are read from the first half of the block, the outputs are written to the second one
+	constexpr std::size_t warmup_output_offset = warmup_block_size / 2;
+
+	// two elements with a gap between them reach the indexed kernels of strided tensors
+	GALILEO_TENSOR GetWarmupTensor(GALILEO_QUEUE queue, void* ptr, GALILEO_DATA_TYPE data_type, unsigned int size = 1, unsigned int stride = 1) {
+		GALILEO_TENSOR tensor{};
+		tensor.associated_queue = queue;
+		tensor.tensor_data = ptr;
+		tensor.data_type = data_type;
+		tensor.dimensions.tensor_dimensions[0] = size;
+		tensor.dimensions.tensor_strides[0] = stride;
+		tensor.dimensions.tensor_dimensions_size = 1;
+		tensor.allocation_kind = GALILEO_ALLOCATION_DEVICE;
+		tensor.validated_data = ptr;
+		return tensor;
+	}
+
+	// binary ops write the promoted type, e.g. int32 for int8 operands
+	template <typename Kernel, std::size_t inputs_size>
+	GALILEO_DATA_TYPE GetWarmupOutputDataType(GALILEO_DATA_TYPE data_type) {
+		if constexpr (inputs_size == 1)
+			return data_type;
+		else
+			return Kernel::GetOutputDataType(data_type, data_type);
+	}
+
+	// the kernels of every selected data type are compiled by one-element launches, aligned for the vectorized kernel and misaligned for the plain one,
+	// and by a two-element strided launch for the indexed kernel
+	template <typename Kernel, std::size_t inputs_size>
+	void WarmupOp(GALILEO_QUEUE queue, void* block, unsigned int type_mask, GALILEO_WARMUP_STATISTICS& statistics, const std::vector<sycl::event>& dependencies) {
+		for (int data_type = GALILEO_UINT8; data_type <= GALILEO_BFLOAT16; ++data_type) {
+			if (!(type_mask & (1u << data_type)))
+				continue;
+			try {
+				const auto input_data_type = static_cast<GALILEO_DATA_TYPE>(data_type);
+				const auto output_data_type = GetWarmupOutputDataType<Kernel, inputs_size>(input_data_type);
+				const auto input_element_size = galileo::common::GetDataTypeSize(input_data_type);
+				const auto output_element_size = galileo::common::GetDataTypeSize(output_data_type);
+				auto input_ptr = static_cast<std::byte*>(block);
+				auto output_ptr = input_ptr + warmup_output_offset;
+
+				auto launch = [&](const GALILEO_TENSOR& input, GALILEO_TENSOR output) {
+					if constexpr (inputs_size == 1) {
+						Kernel kernel(input, output);
+						galileo::common::Submit(queue, kernel, dependencies);
+					}
+					else {
+						Kernel kernel(input, input, output);
+						galileo::common::Submit(queue, kernel, dependencies);
+					}
+				};
+				launch(GetWarmupTensor(queue, input_ptr, input_data_type), GetWarmupTensor(queue, output_ptr, output_data_type));
+				launch(GetWarmupTensor(queue, input_ptr + input_element_size, input_data_type), GetWarmupTensor(queue, output_ptr + output_element_size, output_data_type));
+				launch(GetWarmupTensor(queue, input_ptr, input_data_type, 2, 2), GetWarmupTensor(queue, output_ptr, output_data_type, 2));
+				++statistics.kernels;
+			}
+			catch (GALILEO_RESULT) {
+				++statistics.skipped;
+			}
+			catch (const std::exception&) {
+				++statistics.skipped;
+			}
+		}
+	}
+}
+
+GALILEO_RESULT GALILEO_Warmup(GALILEO_QUEUE queue, unsigned long long op_mask, unsigned int type_mask) {
+	try {
+		if (!queue)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		auto& context = galileo::common::GetQueueContext(queue);
+		if (context.capture)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		const auto start = std::chrono::steady_clock::now();
+		auto& statistics = context.warmup;
+		auto block = context.pool.Allocate(warmup_block_size, GALILEO_ALLOCATION_DEVICE);
+		// ones keep the integer division of the warm-up launches defined
+		auto fill = [=](sycl::handler& h) { h.memset(block, 1, warmup_block_size); };
+		const std::vector<sycl::event> dependencies = { galileo::common::Submit(queue, fill, {}) };
+
+		GALILEO_UNARY_OPS(WARMUP_UNARY_OP)
+		GALILEO_BINARY_OPS(WARMUP_BINARY_OP)
+
+		galileo::common::GetQueue(queue).wait();
+		context.pool.Deallocate(block);
+		statistics.milliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+	catch (GALILEO_RESULT res) {
+		return res;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+	return GALILEO_RESULT::GALILEO_RESULT_OK;
+}
+
+GALILEO_RESULT GALILEO_GetWarmupStatistics(GALILEO_QUEUE queue, GALILEO_WARMUP_STATISTICS* statistics) {
+	try {
+		if (!queue || !statistics)
+			return GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER;
+
+		*statistics = galileo::common::GetQueueContext(queue).warmup;
+		return GALILEO_RESULT::GALILEO_RESULT_OK;
+	}
+	catch (GALILEO_RESULT result) {
+		return result;
+	}
+	catch (...) {
+		return GALILEO_RESULT::GALILEO_RESULT_UNKNOWN_ERROR;
+	}
+}
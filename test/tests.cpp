@@ -2,6 +2,17 @@
 #include "galileo.h"
 #include "unary.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <vector>
+
 #include <sycl/sycl.hpp>
 
 inline namespace helpers {
@@ -17,6 +28,19 @@ inline namespace helpers {
 			throw result;
 		return queue_ptr;
 	}
+
+	auto GetShardedQueue(GALILEO_SHARDING sharding) {
+		unsigned int size = 0;
+		auto result = GALILEO_GetQueueSize(&size);
+		if (result != GALILEO_RESULT::GALILEO_RESULT_OK)
+			throw result;
+
+		auto queue_ptr = std::unique_ptr<std::byte[], std::function<GALILEO_RESULT(GALILEO_QUEUE)>>(new std::byte[size], GALILEO_ReleaseQueue);
+		result = GALILEO_InitShardedQueue(queue_ptr.get(), sharding);
+		if (result != GALILEO_RESULT::GALILEO_RESULT_OK)
+			throw result;
+		return queue_ptr;
+	}
 }
 
 TEST(InfrastructureTests, GetLibVersion) {
@@ -41,10 +65,45 @@ TEST(InfrastructureTests, InitAndReleaseQueue) {
 	auto queue_ptr = GetQueue();
 }
 
+TEST(InfrastructureTests, InitQueueWithProperties) {
+	unsigned int count = 0;
+	ASSERT_EQ(GALILEO_EnumerateDevices(nullptr, &count), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_GT(count, 0u);
+	std::vector<GALILEO_DEVICE_INFO> devices(count);
+	ASSERT_EQ(GALILEO_EnumerateDevices(devices.data(), &count), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(count, devices.size());
+
+	unsigned int size = 0;
+	ASSERT_EQ(GALILEO_GetQueueSize(&size), GALILEO_RESULT::GALILEO_RESULT_OK);
+	auto queue_ptr = std::unique_ptr<std::byte[], std::function<GALILEO_RESULT(GALILEO_QUEUE)>>(new std::byte[size], GALILEO_ReleaseQueue);
+	GALILEO_QUEUE_PROPERTIES properties = {};
+	properties.device_type = devices[0].device_type;
+	properties.device_index = devices[0].device_index + count;
+	ASSERT_EQ(GALILEO_InitQueueEx(queue_ptr.get(), &properties), GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER);
+	properties.device_index = devices[0].device_index;
+	properties.in_order = 1;
+	properties.enable_profiling = 1;
+	ASSERT_EQ(GALILEO_InitQueueEx(queue_ptr.get(), &properties), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_TRUE(galileo::common::GetQueue(queue_ptr.get()).is_in_order());
+
+	constexpr unsigned int elements = 100;
+	float* data = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, elements, reinterpret_cast<void**>(&data)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	std::iota(data, data + elements, 0.f);
+	GALILEO_TENSOR tensor = {};
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), data, GALILEO_FLOAT, elements, &tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Add(&tensor, &tensor, &tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Add(&tensor, &tensor, &tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < elements; ++i)
+		ASSERT_FLOAT_EQ(data[i], 4.f * i);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), data), GALILEO_RESULT::GALILEO_RESULT_OK);
+}
+
 TEST(InfrastructureTests, AllocateDeallocate) {
 	auto queue_ptr = GetQueue();
 	constexpr auto size = 1024;
-	for (auto type = static_cast<int>(GALILEO_UINT8); type <= static_cast<int>(GALILEO_COMPLEX_HALF); ++type) {
+	for (auto type = static_cast<int>(GALILEO_UINT8); type <= static_cast<int>(GALILEO_BFLOAT16); ++type) {
 		void* ptr = nullptr;
 		auto result = GALILEO_Allocate(queue_ptr.get(), static_cast<GALILEO_DATA_TYPE>(type), size, &ptr);
 		ASSERT_EQ(result, GALILEO_RESULT::GALILEO_RESULT_OK);
@@ -52,3 +111,1332 @@ TEST(InfrastructureTests, AllocateDeallocate) {
 		ASSERT_EQ(result, GALILEO_RESULT::GALILEO_RESULT_OK);
 	}
 }
+
+TEST(InfrastructureTests, ReleaseQueueKeepsUserMemory) {
+	auto queue_ptr = GetQueue();
+	constexpr auto size = 1024;
+	float* ptr = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, size, reinterpret_cast<void**>(&ptr)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (int i = 0; i < size; ++i)
+		ptr[i] = static_cast<float>(i);
+
+	queue_ptr.reset();
+	for (int i = 0; i < size; ++i)
+		ASSERT_EQ(ptr[i], static_cast<float>(i));
+}
+
+TEST(ExpressionTests, FusedAddMulExp) {
+	auto queue_ptr = GetQueue();
+	constexpr auto size = 1024;
+	float* ptrs[4] = {};
+	GALILEO_TENSOR tensors[4] = {};
+	for (int i = 0; i < 4; ++i) {
+		auto result = GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, size, reinterpret_cast<void**>(&ptrs[i]));
+		ASSERT_EQ(result, GALILEO_RESULT::GALILEO_RESULT_OK);
+		result = GALILEO_Create1dTensor(queue_ptr.get(), ptrs[i], GALILEO_FLOAT, size, &tensors[i]);
+		ASSERT_EQ(result, GALILEO_RESULT::GALILEO_RESULT_OK);
+	}
+	for (int i = 0; i < size; ++i) {
+		ptrs[0][i] = static_cast<float>(i);
+		ptrs[1][i] = 0.5f;
+		ptrs[2][i] = static_cast<float>(i % 4) * 0.25f;
+	}
+
+	GALILEO_EXPRESSION expression = nullptr;
+	ASSERT_EQ(GALILEO_CreateExpression(queue_ptr.get(), &expression), GALILEO_RESULT::GALILEO_RESULT_OK);
+	GALILEO_EXPRESSION_NODE a = 0, b = 0, c = 0, mul = 0, exp = 0, add = 0;
+	ASSERT_EQ(GALILEO_ExpressionInput(expression, &tensors[0], &a), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionInput(expression, &tensors[1], &b), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionInput(expression, &tensors[2], &c), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionBinary(expression, GALILEO_OP_MUL, a, b, &mul), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionUnary(expression, GALILEO_OP_EXP, c, &exp), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionBinary(expression, GALILEO_OP_ADD, mul, exp, &add), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionUnary(expression, GALILEO_OP_ADD, a, &add), GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER);
+	ASSERT_EQ(GALILEO_ExpressionOutput(expression, add, &tensors[3]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionEvaluate(expression), GALILEO_RESULT::GALILEO_RESULT_OK);
+	galileo::common::GetQueue(queue_ptr.get()).wait();
+
+	for (int i = 0; i < size; ++i)
+		ASSERT_NEAR(ptrs[3][i], ptrs[0][i] * ptrs[1][i] + std::exp(ptrs[2][i]), 1e-3f);
+
+	ASSERT_EQ(GALILEO_ReleaseExpression(expression), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (auto ptr : ptrs)
+		ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), ptr), GALILEO_RESULT::GALILEO_RESULT_OK);
+}
+
+TEST(ExpressionTests, FusedIntegerPromotion) {
+	auto queue_ptr = GetQueue();
+	constexpr auto size = 1000;
+	std::int8_t* lhs = nullptr;
+	std::int32_t* ptrs[3] = {};
+	GALILEO_TENSOR lhs_tensor{}, tensors[3] = {}, narrow_tensor{};
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT8, size, reinterpret_cast<void**>(&lhs)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), lhs, GALILEO_INT8, size, &lhs_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), lhs, GALILEO_INT8, size, &narrow_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (int i = 0; i < 3; ++i) {
+		ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT32, size, reinterpret_cast<void**>(&ptrs[i])), GALILEO_RESULT::GALILEO_RESULT_OK);
+		ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), ptrs[i], GALILEO_INT32, size, &tensors[i]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	}
+	for (int i = 0; i < size; ++i) {
+		lhs[i] = static_cast<std::int8_t>(i % 256 - 128);
+		ptrs[0][i] = i * 1000;
+	}
+
+	// int8 + int32 runs in int32 like GALILEO_Add, both results are outputs
+	GALILEO_EXPRESSION expression = nullptr;
+	ASSERT_EQ(GALILEO_CreateExpression(queue_ptr.get(), &expression), GALILEO_RESULT::GALILEO_RESULT_OK);
+	GALILEO_EXPRESSION_NODE a = 0, b = 0, add = 0, mul = 0;
+	ASSERT_EQ(GALILEO_ExpressionInput(expression, &lhs_tensor, &a), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionInput(expression, &tensors[0], &b), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionBinary(expression, GALILEO_OP_ADD, a, b, &add), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionBinary(expression, GALILEO_OP_MUL, add, a, &mul), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionOutput(expression, mul, &narrow_tensor), GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE);
+	ASSERT_EQ(GALILEO_ExpressionOutput(expression, add, &tensors[1]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionOutput(expression, mul, &tensors[2]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionEvaluate(expression), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	for (int i = 0; i < size; ++i) {
+		ASSERT_EQ(ptrs[1][i], lhs[i] + ptrs[0][i]);
+		ASSERT_EQ(ptrs[2][i], (lhs[i] + ptrs[0][i]) * lhs[i]);
+	}
+
+	ASSERT_EQ(GALILEO_ReleaseExpression(expression), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), lhs), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (auto ptr : ptrs)
+		ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), ptr), GALILEO_RESULT::GALILEO_RESULT_OK);
+}
+
+TEST(ExpressionTests, CapturedScratchOutlivesExpression) {
+	auto queue_ptr = GetQueue();
+	constexpr auto size = 1000;
+	std::int8_t* lhs = nullptr;
+	std::int32_t* ptrs[2] = {};
+	GALILEO_TENSOR lhs_tensor{}, tensors[2] = {};
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT8, size, reinterpret_cast<void**>(&lhs)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), lhs, GALILEO_INT8, size, &lhs_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (int i = 0; i < 2; ++i) {
+		ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT32, size, reinterpret_cast<void**>(&ptrs[i])), GALILEO_RESULT::GALILEO_RESULT_OK);
+		ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), ptrs[i], GALILEO_INT32, size, &tensors[i]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	}
+
+	// the int8 input is promoted into a scratch block read by the int32 kernel
+	GALILEO_EXPRESSION expression = nullptr;
+	ASSERT_EQ(GALILEO_CreateExpression(queue_ptr.get(), &expression), GALILEO_RESULT::GALILEO_RESULT_OK);
+	GALILEO_EXPRESSION_NODE a = 0, b = 0, add = 0, mul = 0;
+	ASSERT_EQ(GALILEO_ExpressionInput(expression, &lhs_tensor, &a), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionInput(expression, &tensors[0], &b), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionBinary(expression, GALILEO_OP_ADD, a, b, &add), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionBinary(expression, GALILEO_OP_MUL, add, a, &mul), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionOutput(expression, mul, &tensors[1]), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	ASSERT_EQ(GALILEO_BeginCapture(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionEvaluate(expression), GALILEO_RESULT::GALILEO_RESULT_OK);
+	GALILEO_GRAPH graph = nullptr;
+	ASSERT_EQ(GALILEO_EndCapture(queue_ptr.get(), &graph), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ReleaseExpression(expression), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	// pool blocks handed out now must not alias the scratch the graph still uses
+	std::int32_t* other = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT32, size, reinterpret_cast<void**>(&other)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (int i = 0; i < size; ++i) {
+		lhs[i] = static_cast<std::int8_t>(i % 256 - 128);
+		ptrs[0][i] = i * 1000;
+		other[i] = -1;
+	}
+
+	ASSERT_EQ(GALILEO_GraphLaunch(graph), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (int i = 0; i < size; ++i) {
+		ASSERT_EQ(ptrs[1][i], (lhs[i] + ptrs[0][i]) * lhs[i]);
+		ASSERT_EQ(other[i], -1);
+	}
+
+	ASSERT_EQ(GALILEO_ReleaseGraph(graph), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), other), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), lhs), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (auto ptr : ptrs)
+		ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), ptr), GALILEO_RESULT::GALILEO_RESULT_OK);
+}
+
+TEST(ExpressionTests, FusedComplex) {
+	auto queue_ptr = GetQueue();
+	constexpr auto size = 513;
+	std::complex<float>* ptrs[3] = {};
+	GALILEO_TENSOR tensors[3] = {};
+	for (int i = 0; i < 3; ++i) {
+		ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_COMPLEX_FLOAT, size, reinterpret_cast<void**>(&ptrs[i])), GALILEO_RESULT::GALILEO_RESULT_OK);
+		ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), ptrs[i], GALILEO_COMPLEX_FLOAT, size, &tensors[i]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	}
+	for (int i = 0; i < size; ++i) {
+		ptrs[0][i] = { static_cast<float>(i % 7), 1.0f };
+		ptrs[1][i] = { 0.5f, static_cast<float>(i % 3) };
+	}
+
+	GALILEO_EXPRESSION expression = nullptr;
+	ASSERT_EQ(GALILEO_CreateExpression(queue_ptr.get(), &expression), GALILEO_RESULT::GALILEO_RESULT_OK);
+	GALILEO_EXPRESSION_NODE a = 0, b = 0, mul = 0, sub = 0;
+	ASSERT_EQ(GALILEO_ExpressionInput(expression, &tensors[0], &a), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionInput(expression, &tensors[1], &b), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionBinary(expression, GALILEO_OP_MUL, a, b, &mul), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionBinary(expression, GALILEO_OP_SUB, mul, a, &sub), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionOutput(expression, sub, &tensors[2]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionEvaluate(expression), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	for (int i = 0; i < size; ++i) {
+		const auto expected = ptrs[0][i] * ptrs[1][i] - ptrs[0][i];
+		ASSERT_NEAR(ptrs[2][i].real(), expected.real(), 1e-4f);
+		ASSERT_NEAR(ptrs[2][i].imag(), expected.imag(), 1e-4f);
+	}
+
+	ASSERT_EQ(GALILEO_ReleaseExpression(expression), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (auto ptr : ptrs)
+		ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), ptr), GALILEO_RESULT::GALILEO_RESULT_OK);
+}
+
+TEST(AsyncTests, DependencyChain) {
+	auto queue_ptr = GetQueue();
+	constexpr auto size = 1024;
+	float* ptrs[3] = {};
+	GALILEO_TENSOR tensors[3] = {};
+	for (int i = 0; i < 3; ++i) {
+		ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, size, reinterpret_cast<void**>(&ptrs[i])), GALILEO_RESULT::GALILEO_RESULT_OK);
+		ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), ptrs[i], GALILEO_FLOAT, size, &tensors[i]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	}
+	for (int i = 0; i < size; ++i) {
+		ptrs[0][i] = static_cast<float>(i);
+		ptrs[1][i] = 2.0f;
+	}
+
+	GALILEO_EVENT mul_event = nullptr;
+	GALILEO_EVENT add_event = nullptr;
+	ASSERT_EQ(GALILEO_MulAsync(&tensors[0], &tensors[1], &tensors[2], nullptr, 0, &mul_event), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_AddAsync(&tensors[2], &tensors[1], &tensors[2], &mul_event, 1, &add_event), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_WaitEvents(&add_event, 1), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	for (int i = 0; i < size; ++i)
+		ASSERT_FLOAT_EQ(ptrs[2][i], static_cast<float>(i) * 2.0f + 2.0f);
+
+	ASSERT_EQ(GALILEO_AddAsync(&tensors[0], &tensors[1], &tensors[2], nullptr, 1, nullptr), GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER);
+	ASSERT_EQ(GALILEO_ReleaseEvent(mul_event), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ReleaseEvent(add_event), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (auto ptr : ptrs)
+		ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), ptr), GALILEO_RESULT::GALILEO_RESULT_OK);
+}
+
+TEST(InfrastructureTests, PoolReusesReleasedBlocks) {
+	auto queue_ptr = GetQueue();
+	constexpr auto size = 1000;
+	void* ptr = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, size, &ptr), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), ptr), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	void* reused_ptr = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT32, size, &reused_ptr), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(reused_ptr, ptr);
+
+	GALILEO_POOL_STATISTICS statistics = {};
+	ASSERT_EQ(GALILEO_GetPoolStatistics(queue_ptr.get(), &statistics), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(statistics.allocations, 2u);
+	ASSERT_EQ(statistics.cache_hits, 1u);
+	ASSERT_EQ(statistics.device_allocations, 1u);
+	ASSERT_GE(statistics.used_bytes, size * sizeof(float));
+
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), reused_ptr), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_TrimPool(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_GetPoolStatistics(queue_ptr.get(), &statistics), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(statistics.reserved_bytes, 0u);
+	ASSERT_EQ(statistics.cached_bytes, 0u);
+}
+
+TEST(InfrastructureTests, DeviceTensorRoundTrip) {
+	auto queue_ptr = GetQueue();
+	constexpr auto size = 1024;
+	std::vector<float> host_data(size);
+	std::iota(host_data.begin(), host_data.end(), 0.0f);
+
+	void* device_ptr = nullptr;
+	void* host_ptr = nullptr;
+	ASSERT_EQ(GALILEO_AllocateEx(queue_ptr.get(), GALILEO_FLOAT, size, GALILEO_ALLOCATION_DEVICE, &device_ptr), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_AllocateEx(queue_ptr.get(), GALILEO_FLOAT, size, GALILEO_ALLOCATION_HOST, &host_ptr), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	GALILEO_TENSOR device_tensor = {};
+	GALILEO_TENSOR host_tensor = {};
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), device_ptr, GALILEO_FLOAT, size, &device_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), host_ptr, GALILEO_FLOAT, size, &host_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(device_tensor.allocation_kind, GALILEO_ALLOCATION_DEVICE);
+	ASSERT_EQ(host_tensor.allocation_kind, GALILEO_ALLOCATION_HOST);
+
+	ASSERT_EQ(GALILEO_Memcpy(queue_ptr.get(), device_ptr, host_data.data(), size * sizeof(float)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Neg(&device_tensor, &host_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	auto result = static_cast<float*>(host_ptr);
+	for (int i = 0; i < size; ++i)
+		ASSERT_FLOAT_EQ(result[i], -host_data[i]);
+
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), device_ptr), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), host_ptr), GALILEO_RESULT::GALILEO_RESULT_OK);
+}
+
+TEST(InfrastructureTests, PointerValidation) {
+	auto queue_ptr = GetQueue();
+	constexpr auto size = 1024;
+	void* ptr = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, size, &ptr), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	GALILEO_TENSOR tensor = {};
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), ptr, GALILEO_FLOAT, size, &tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(tensor.validated_data, ptr);
+	ASSERT_EQ(GALILEO_Abs(&tensor, &tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	// a copied tensor pointing to foreign memory loses the trusted state
+	float host_data[size] = {};
+	auto incorrect = tensor;
+	incorrect.tensor_data = host_data;
+	ASSERT_EQ(GALILEO_Abs(&incorrect, &tensor), GALILEO_RESULT::GALILEO_RESULT_NON_USM_POINTER);
+	ASSERT_EQ(GALILEO_RegisterPointer(queue_ptr.get(), host_data, sizeof(host_data)), GALILEO_RESULT::GALILEO_RESULT_NON_USM_POINTER);
+
+	// views into a registered allocation are resolved by the registry
+	auto view = tensor;
+	view.tensor_data = static_cast<float*>(ptr) + size / 2;
+	view.dimensions.tensor_dimensions[0] = size / 2;
+	ASSERT_EQ(GALILEO_Abs(&view, &view), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), ptr), GALILEO_RESULT::GALILEO_RESULT_OK);
+}
+
+TEST(InfrastructureTests, BroadcastAndStridedViews) {
+	auto queue_ptr = GetQueue();
+	constexpr unsigned int rows = 4;
+	constexpr unsigned int columns = 3;
+	float* matrix = nullptr;
+	float* bias = nullptr;
+	float* result = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, rows * columns, reinterpret_cast<void**>(&matrix)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, columns, reinterpret_cast<void**>(&bias)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, rows * columns, reinterpret_cast<void**>(&result)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	std::iota(matrix, matrix + rows * columns, 0.f);
+	std::iota(bias, bias + columns, 100.f);
+
+	const unsigned int matrix_dimensions[] = { rows, columns };
+	GALILEO_TENSOR matrix_tensor = {};
+	GALILEO_TENSOR bias_tensor = {};
+	GALILEO_TENSOR result_tensor = {};
+	ASSERT_EQ(GALILEO_CreateNdTensor(queue_ptr.get(), matrix, GALILEO_FLOAT, matrix_dimensions, nullptr, 2, &matrix_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), bias, GALILEO_FLOAT, columns, &bias_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_CreateNdTensor(queue_ptr.get(), result, GALILEO_FLOAT, matrix_dimensions, nullptr, 2, &result_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	// the bias row is stretched over every row of the matrix
+	ASSERT_EQ(GALILEO_Add(&matrix_tensor, &bias_tensor, &result_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < rows * columns; ++i)
+		ASSERT_FLOAT_EQ(result[i], matrix[i] + bias[i % columns]);
+	ASSERT_EQ(GALILEO_Add(&bias_tensor, &matrix_tensor, &bias_tensor), GALILEO_RESULT::GALILEO_RESULT_TENSOR_DIMENSIONS_MISMATCH);
+
+	// transposed view of the matrix written into a contiguous columns x rows tensor
+	const unsigned int transposed_dimensions[] = { columns, rows };
+	const unsigned int transposed_strides[] = { 1, columns };
+	GALILEO_TENSOR transposed_tensor = {};
+	GALILEO_TENSOR transposed_result_tensor = {};
+	ASSERT_EQ(GALILEO_CreateNdTensor(queue_ptr.get(), matrix, GALILEO_FLOAT, transposed_dimensions, transposed_strides, 2, &transposed_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_CreateNdTensor(queue_ptr.get(), result, GALILEO_FLOAT, transposed_dimensions, nullptr, 2, &transposed_result_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	// strides reaching past the end of the allocation
+	const unsigned int overrunning_strides[] = { 1, columns + 1 };
+	GALILEO_TENSOR overrunning_tensor = {};
+	ASSERT_EQ(GALILEO_CreateNdTensor(queue_ptr.get(), matrix, GALILEO_FLOAT, transposed_dimensions, overrunning_strides, 2, &overrunning_tensor), GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER);
+	ASSERT_EQ(GALILEO_CreateNdTensor(queue_ptr.get(), matrix + 1, GALILEO_FLOAT, matrix_dimensions, nullptr, 2, &overrunning_tensor), GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER);
+	ASSERT_EQ(GALILEO_Neg(&transposed_tensor, &transposed_result_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < columns; ++i)
+		for (unsigned int j = 0; j < rows; ++j)
+			ASSERT_FLOAT_EQ(result[i * rows + j], -matrix[j * columns + i]);
+
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), matrix), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), bias), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), result), GALILEO_RESULT::GALILEO_RESULT_OK);
+}
+
+TEST(InfrastructureTests, VectorizedTailAndUnalignedViews) {
+	auto queue_ptr = GetQueue();
+	// not a multiple of any vector width, the remainder is processed by the last work-item
+	constexpr unsigned int size = 1027;
+	std::int32_t* lhs = nullptr;
+	std::int32_t* rhs = nullptr;
+	std::int32_t* result = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT32, size, reinterpret_cast<void**>(&lhs)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT32, size, reinterpret_cast<void**>(&rhs)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT32, size, reinterpret_cast<void**>(&result)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < size; ++i) {
+		lhs[i] = static_cast<std::int32_t>(i);
+		rhs[i] = static_cast<std::int32_t>(2 * i);
+	}
+
+	GALILEO_TENSOR tensors[3] = {};
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), lhs, GALILEO_INT32, size, &tensors[0]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), rhs, GALILEO_INT32, size, &tensors[1]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), result, GALILEO_INT32, size, &tensors[2]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Sub(&tensors[1], &tensors[0], &tensors[2]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < size; ++i)
+		ASSERT_EQ(result[i], lhs[i]);
+
+	// views shifted by one element are not vector-aligned and take the scalar path
+	GALILEO_TENSOR shifted[2] = {};
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), lhs + 1, GALILEO_INT32, size - 1, &shifted[0]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), result + 1, GALILEO_INT32, size - 1, &shifted[1]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Neg(&shifted[0], &shifted[1]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 1; i < size; ++i)
+		ASSERT_EQ(result[i], -lhs[i]);
+
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), lhs), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), rhs), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), result), GALILEO_RESULT::GALILEO_RESULT_OK);
+}
+
+TEST(ReductionTests, FullAndAxisReductions) {
+	auto queue_ptr = GetQueue();
+	constexpr unsigned int rows = 3;
+	constexpr unsigned int columns = 5;
+	float* input = nullptr;
+	float* output = nullptr;
+	std::int64_t* indices = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, rows * columns, reinterpret_cast<void**>(&input)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, columns, reinterpret_cast<void**>(&output)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT64, rows, reinterpret_cast<void**>(&indices)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < rows * columns; ++i)
+		input[i] = static_cast<float>((i * 7) % 11);
+
+	const unsigned int dimensions[] = { rows, columns };
+	GALILEO_TENSOR input_tensor = {};
+	GALILEO_TENSOR scalar_tensor = {};
+	GALILEO_TENSOR columns_tensor = {};
+	GALILEO_TENSOR indices_tensor = {};
+	ASSERT_EQ(GALILEO_CreateNdTensor(queue_ptr.get(), input, GALILEO_FLOAT, dimensions, nullptr, 2, &input_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), output, GALILEO_FLOAT, 1, &scalar_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), output, GALILEO_FLOAT, columns, &columns_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), indices, GALILEO_INT64, rows, &indices_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	ASSERT_EQ(GALILEO_Sum(&input_tensor, GALILEO_REDUCE_ALL_AXES, &scalar_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_FLOAT_EQ(output[0], std::accumulate(input, input + rows * columns, 0.f));
+
+	ASSERT_EQ(GALILEO_Max(&input_tensor, 0, &columns_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int j = 0; j < columns; ++j)
+		ASSERT_FLOAT_EQ(output[j], std::max({ input[j], input[columns + j], input[2 * columns + j] }));
+
+	ASSERT_EQ(GALILEO_ArgMin(&input_tensor, 1, &indices_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < rows; ++i)
+		ASSERT_EQ(indices[i], std::min_element(input + i * columns, input + (i + 1) * columns) - (input + i * columns));
+
+	// the output has to match the remaining dimensions
+	ASSERT_EQ(GALILEO_Max(&input_tensor, 1, &columns_tensor), GALILEO_RESULT::GALILEO_RESULT_TENSOR_DIMENSIONS_MISMATCH);
+	ASSERT_EQ(GALILEO_ArgMin(&input_tensor, 1, &columns_tensor), GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE);
+
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), input), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), output), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), indices), GALILEO_RESULT::GALILEO_RESULT_OK);
+}
+
+TEST(ReductionTests, LongAxis) {
+	auto queue_ptr = GetQueue();
+	// rows long enough to be reduced by a work-group each
+	constexpr unsigned int rows = 4;
+	constexpr unsigned int columns = 5000;
+	std::int32_t* input = nullptr;
+	std::int32_t* output = nullptr;
+	std::int64_t* indices = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT32, rows * columns, reinterpret_cast<void**>(&input)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT32, rows, reinterpret_cast<void**>(&output)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT64, rows, reinterpret_cast<void**>(&indices)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < rows * columns; ++i)
+		input[i] = static_cast<std::int32_t>((i * 7919) % 1000);
+
+	const unsigned int dimensions[] = { rows, columns };
+	GALILEO_TENSOR input_tensor = {};
+	GALILEO_TENSOR output_tensor = {};
+	GALILEO_TENSOR indices_tensor = {};
+	ASSERT_EQ(GALILEO_CreateNdTensor(queue_ptr.get(), input, GALILEO_INT32, dimensions, nullptr, 2, &input_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), output, GALILEO_INT32, rows, &output_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), indices, GALILEO_INT64, rows, &indices_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	ASSERT_EQ(GALILEO_Sum(&input_tensor, 1, &output_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ArgMax(&input_tensor, 1, &indices_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < rows; ++i) {
+		ASSERT_EQ(output[i], std::accumulate(input + i * columns, input + (i + 1) * columns, 0));
+		ASSERT_EQ(indices[i], std::max_element(input + i * columns, input + (i + 1) * columns) - (input + i * columns));
+	}
+
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), input), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), output), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), indices), GALILEO_RESULT::GALILEO_RESULT_OK);
+}
+
+TEST(ReductionTests, InfinityAndNan) {
+	auto queue_ptr = GetQueue();
+	constexpr unsigned int size = 100;
+	constexpr auto infinity = std::numeric_limits<float>::infinity();
+	float* input = nullptr;
+	float* output = nullptr;
+	std::int64_t* index = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, size, reinterpret_cast<void**>(&input)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, 1, reinterpret_cast<void**>(&output)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT64, 1, reinterpret_cast<void**>(&index)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	GALILEO_TENSOR input_tensor = {};
+	GALILEO_TENSOR output_tensor = {};
+	GALILEO_TENSOR index_tensor = {};
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), input, GALILEO_FLOAT, size, &input_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), output, GALILEO_FLOAT, 1, &output_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), index, GALILEO_INT64, 1, &index_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	// infinite inputs reduce to themselves and to the first index
+	std::fill(input, input + size, infinity);
+	ASSERT_EQ(GALILEO_Min(&input_tensor, GALILEO_REDUCE_ALL_AXES, &output_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(*output, infinity);
+	ASSERT_EQ(GALILEO_ArgMin(&input_tensor, GALILEO_REDUCE_ALL_AXES, &index_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(*index, 0);
+
+	std::fill(input, input + size, -infinity);
+	ASSERT_EQ(GALILEO_Max(&input_tensor, GALILEO_REDUCE_ALL_AXES, &output_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(*output, -infinity);
+	ASSERT_EQ(GALILEO_ArgMax(&input_tensor, GALILEO_REDUCE_ALL_AXES, &index_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(*index, 0);
+
+	// NaN propagates and the first one is reported
+	std::fill(input, input + size, std::numeric_limits<float>::quiet_NaN());
+	ASSERT_EQ(GALILEO_Min(&input_tensor, GALILEO_REDUCE_ALL_AXES, &output_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_TRUE(std::isnan(*output));
+	ASSERT_EQ(GALILEO_ArgMin(&input_tensor, GALILEO_REDUCE_ALL_AXES, &index_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(*index, 0);
+
+	std::iota(input, input + size, 0.f);
+	input[37] = std::numeric_limits<float>::quiet_NaN();
+	input[61] = std::numeric_limits<float>::quiet_NaN();
+	ASSERT_EQ(GALILEO_Max(&input_tensor, GALILEO_REDUCE_ALL_AXES, &output_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_TRUE(std::isnan(*output));
+	ASSERT_EQ(GALILEO_ArgMax(&input_tensor, GALILEO_REDUCE_ALL_AXES, &index_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(*index, 37);
+
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), input), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), output), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), index), GALILEO_RESULT::GALILEO_RESULT_OK);
+}
+
+TEST(ScanTests, CumSumAndCompact) {
+	auto queue_ptr = GetQueue();
+	// spans several scan blocks, so the block offsets are scanned recursively
+	constexpr unsigned int size = 100000;
+	std::int32_t* input = nullptr;
+	std::int32_t* output = nullptr;
+	std::uint8_t* mask = nullptr;
+	std::int64_t* count = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT32, size, reinterpret_cast<void**>(&input)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT32, size, reinterpret_cast<void**>(&output)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_UINT8, size, reinterpret_cast<void**>(&mask)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT64, 1, reinterpret_cast<void**>(&count)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < size; ++i) {
+		input[i] = static_cast<std::int32_t>(i % 7) - 3;
+		mask[i] = i % 3 == 0;
+	}
+
+	GALILEO_TENSOR tensors[4] = {};
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), input, GALILEO_INT32, size, &tensors[0]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), output, GALILEO_INT32, size, &tensors[1]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), mask, GALILEO_UINT8, size, &tensors[2]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), count, GALILEO_INT64, 1, &tensors[3]), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	ASSERT_EQ(GALILEO_CumSum(&tensors[0], GALILEO_SCAN_INCLUSIVE, &tensors[1]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	std::vector<std::int32_t> expected(size);
+	std::inclusive_scan(input, input + size, expected.begin());
+	ASSERT_TRUE(std::equal(expected.begin(), expected.end(), output));
+
+	ASSERT_EQ(GALILEO_CumSum(&tensors[0], GALILEO_SCAN_EXCLUSIVE, &tensors[1]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	std::exclusive_scan(input, input + size, expected.begin(), 0);
+	ASSERT_TRUE(std::equal(expected.begin(), expected.end(), output));
+
+	ASSERT_EQ(GALILEO_Compact(&tensors[0], &tensors[2], &tensors[1], &tensors[3]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(*count, static_cast<std::int64_t>((size + 2) / 3));
+	for (std::int64_t i = 0; i < *count; ++i)
+		ASSERT_EQ(output[i], input[3 * i]);
+
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), input), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), output), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), mask), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), count), GALILEO_RESULT::GALILEO_RESULT_OK);
+}
+
+TEST(ScalarTests, ScalarOperandsAndAxpby) {
+	auto queue_ptr = GetQueue();
+	constexpr unsigned int size = 1000;
+	float* x = nullptr;
+	float* y = nullptr;
+	float* result = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, size, reinterpret_cast<void**>(&x)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, size, reinterpret_cast<void**>(&y)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, size, reinterpret_cast<void**>(&result)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < size; ++i) {
+		x[i] = static_cast<float>(i) + 1.f;
+		y[i] = static_cast<float>(size - i);
+	}
+
+	GALILEO_TENSOR tensors[3] = {};
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), x, GALILEO_FLOAT, size, &tensors[0]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), y, GALILEO_FLOAT, size, &tensors[1]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), result, GALILEO_FLOAT, size, &tensors[2]), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	GALILEO_SCALAR scale = {};
+	scale.data_type = GALILEO_FLOAT;
+	scale.value.float_value = 2.5f;
+	ASSERT_EQ(GALILEO_MulScalar(&tensors[0], &scale, &tensors[2]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < size; ++i)
+		ASSERT_FLOAT_EQ(result[i], x[i] * 2.5f);
+
+	ASSERT_EQ(GALILEO_ScalarDiv(&tensors[0], &scale, &tensors[2]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < size; ++i)
+		ASSERT_FLOAT_EQ(result[i], 2.5f / x[i]);
+
+	GALILEO_SCALAR beta = {};
+	beta.data_type = GALILEO_INT32;
+	beta.value.int32_value = -3;
+	ASSERT_EQ(GALILEO_Axpby(&scale, &tensors[0], &beta, &tensors[1], &tensors[2]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < size; ++i)
+		ASSERT_FLOAT_EQ(result[i], 2.5f * x[i] - 3.f * y[i]);
+
+	// outputs narrower than the promoted type and complex scalars of a real output are rejected up front
+	GALILEO_SCALAR wide_scale = {};
+	wide_scale.data_type = GALILEO_DOUBLE;
+	wide_scale.value.double_value = 2.5;
+	ASSERT_EQ(GALILEO_MulScalar(&tensors[0], &wide_scale, &tensors[2]), GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE);
+	GALILEO_SCALAR complex_scale = {};
+	complex_scale.data_type = GALILEO_COMPLEX_FLOAT;
+	complex_scale.value.complex_float_value[0] = 1.f;
+	complex_scale.value.complex_float_value[1] = 1.f;
+	ASSERT_EQ(GALILEO_Axpby(&complex_scale, &tensors[0], &beta, &tensors[1], &tensors[2]), GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE);
+
+	// integer outputs take integral scalars of any type, a fraction would be truncated and is rejected
+	std::int32_t* integers = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT32, size, reinterpret_cast<void**>(&integers)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	std::iota(integers, integers + size, 0);
+	GALILEO_TENSOR integer_tensor = {};
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), integers, GALILEO_INT32, size, &integer_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Axpby(&wide_scale, &integer_tensor, &beta, &integer_tensor, &integer_tensor), GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE);
+	wide_scale.value.double_value = 2.0;
+	ASSERT_EQ(GALILEO_Axpby(&wide_scale, &integer_tensor, &beta, &integer_tensor, &integer_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < size; ++i)
+		ASSERT_EQ(integers[i], -static_cast<std::int32_t>(i));
+	wide_scale.value.double_value = 1e10;
+	ASSERT_EQ(GALILEO_Axpby(&wide_scale, &integer_tensor, &beta, &integer_tensor, &integer_tensor), GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), integers), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), x), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), y), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), result), GALILEO_RESULT::GALILEO_RESULT_OK);
+}
+
+TEST(TernaryTests, ClampWithBroadcastBoundsAndWhere) {
+	auto queue_ptr = GetQueue();
+	constexpr unsigned int size = 256;
+	float* x = nullptr;
+	float* y = nullptr;
+	float* bounds = nullptr;
+	float* result = nullptr;
+	std::uint8_t* mask = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, size, reinterpret_cast<void**>(&x)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, size, reinterpret_cast<void**>(&y)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, 2, reinterpret_cast<void**>(&bounds)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, size, reinterpret_cast<void**>(&result)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_UINT8, size, reinterpret_cast<void**>(&mask)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < size; ++i) {
+		x[i] = static_cast<float>(i) - 128.f;
+		y[i] = static_cast<float>(i);
+		mask[i] = i % 2;
+	}
+	bounds[0] = -10.f;
+	bounds[1] = 20.f;
+
+	GALILEO_TENSOR x_tensor = {};
+	GALILEO_TENSOR y_tensor = {};
+	GALILEO_TENSOR lower_tensor = {};
+	GALILEO_TENSOR upper_tensor = {};
+	GALILEO_TENSOR result_tensor = {};
+	GALILEO_TENSOR mask_tensor = {};
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), x, GALILEO_FLOAT, size, &x_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), y, GALILEO_FLOAT, size, &y_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), bounds, GALILEO_FLOAT, 1, &lower_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), bounds + 1, GALILEO_FLOAT, 1, &upper_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), result, GALILEO_FLOAT, size, &result_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), mask, GALILEO_UINT8, size, &mask_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	// single-element bounds are broadcast over the input
+	ASSERT_EQ(GALILEO_Clamp(&x_tensor, &lower_tensor, &upper_tensor, &result_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < size; ++i)
+		ASSERT_FLOAT_EQ(result[i], std::clamp(x[i], -10.f, 20.f));
+
+	ASSERT_EQ(GALILEO_Where(&mask_tensor, &x_tensor, &y_tensor, &result_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < size; ++i)
+		ASSERT_FLOAT_EQ(result[i], mask[i] ? x[i] : y[i]);
+
+	// narrower operands are promoted to the output type, lossy ones are rejected
+	std::int16_t* addend = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT16, size, reinterpret_cast<void**>(&addend)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < size; ++i)
+		addend[i] = static_cast<std::int16_t>(1000 - 10 * static_cast<int>(i));
+	GALILEO_TENSOR addend_tensor = {};
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), addend, GALILEO_INT16, size, &addend_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Fma(&x_tensor, &y_tensor, &addend_tensor, &result_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < size; ++i)
+		ASSERT_FLOAT_EQ(result[i], x[i] * y[i] + addend[i]);
+
+	std::int32_t* integers = nullptr;
+	std::int8_t* integer_bounds = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT32, size, reinterpret_cast<void**>(&integers)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT8, 2, reinterpret_cast<void**>(&integer_bounds)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < size; ++i)
+		integers[i] = static_cast<std::int32_t>(i) - 128;
+	integer_bounds[0] = -100;
+	integer_bounds[1] = 100;
+	GALILEO_TENSOR integer_tensor = {};
+	GALILEO_TENSOR integer_lower_tensor = {};
+	GALILEO_TENSOR integer_upper_tensor = {};
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), integers, GALILEO_INT32, size, &integer_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), integer_bounds, GALILEO_INT8, 1, &integer_lower_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), integer_bounds + 1, GALILEO_INT8, 1, &integer_upper_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Clamp(&integer_tensor, &integer_lower_tensor, &integer_upper_tensor, &integer_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < size; ++i)
+		ASSERT_EQ(integers[i], std::clamp(static_cast<std::int32_t>(i) - 128, -100, 100));
+
+	// float bounds would be truncated in an int32 output
+	ASSERT_EQ(GALILEO_Clamp(&integer_tensor, &lower_tensor, &upper_tensor, &integer_tensor), GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE);
+
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), addend), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), integers), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), integer_bounds), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), x), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), y), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), bounds), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), result), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), mask), GALILEO_RESULT::GALILEO_RESULT_OK);
+}
+
+TEST(CastTests, SaturatingCastAndQuantizeRoundTrip) {
+	auto queue_ptr = GetQueue();
+	constexpr unsigned int rows = 2;
+	constexpr unsigned int columns = 4;
+	constexpr unsigned int size = rows * columns;
+	float* input = nullptr;
+	float* restored = nullptr;
+	float* scale = nullptr;
+	std::int8_t* quantized = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, size, reinterpret_cast<void**>(&input)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, size, reinterpret_cast<void**>(&restored)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, rows, reinterpret_cast<void**>(&scale)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT8, size, reinterpret_cast<void**>(&quantized)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	const float values[size] = { -1000.f, -2.5f, 1.5f, 300.f, 0.25f, -0.5f, 0.75f, 1.f };
+	std::copy(values, values + size, input);
+	scale[0] = 4.f;
+	scale[1] = 1.f / 64;
+
+	const unsigned int dimensions[] = { rows, columns };
+	GALILEO_TENSOR input_tensor = {};
+	GALILEO_TENSOR restored_tensor = {};
+	GALILEO_TENSOR scale_tensor = {};
+	GALILEO_TENSOR quantized_tensor = {};
+	ASSERT_EQ(GALILEO_CreateNdTensor(queue_ptr.get(), input, GALILEO_FLOAT, dimensions, nullptr, 2, &input_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_CreateNdTensor(queue_ptr.get(), restored, GALILEO_FLOAT, dimensions, nullptr, 2, &restored_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), scale, GALILEO_FLOAT, rows, &scale_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_CreateNdTensor(queue_ptr.get(), quantized, GALILEO_INT8, dimensions, nullptr, 2, &quantized_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	ASSERT_EQ(GALILEO_Cast(&input_tensor, &quantized_tensor, GALILEO_ROUNDING_NEAREST_EVEN, 1), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	const std::int8_t expected[size] = { -128, -2, 2, 127, 0, 0, 1, 1 };
+	ASSERT_TRUE(std::equal(expected, expected + size, quantized));
+
+	// one scale per row, the first row saturates at the int8 range
+	ASSERT_EQ(GALILEO_Quantize(&input_tensor, &scale_tensor, nullptr, 0, &quantized_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Dequantize(&quantized_tensor, &scale_tensor, nullptr, 0, &restored_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_FLOAT_EQ(restored[0], -512.f);
+	ASSERT_FLOAT_EQ(restored[3], 300.f);
+	for (unsigned int i = columns; i < size; ++i)
+		ASSERT_FLOAT_EQ(restored[i], input[i]);
+
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), input), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), restored), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), scale), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), quantized), GALILEO_RESULT::GALILEO_RESULT_OK);
+}
+
+TEST(TypeTests, Bfloat16Arithmetic) {
+	using bfloat16 = sycl::ext::oneapi::bfloat16;
+	auto queue_ptr = GetQueue();
+	constexpr unsigned int size = 100;
+	bfloat16* lhs = nullptr;
+	bfloat16* rhs = nullptr;
+	bfloat16* sum = nullptr;
+	float* exp = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_BFLOAT16, size, reinterpret_cast<void**>(&lhs)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_BFLOAT16, size, reinterpret_cast<void**>(&rhs)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_BFLOAT16, size, reinterpret_cast<void**>(&sum)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, size, reinterpret_cast<void**>(&exp)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	// small integers and their halves are exact in bfloat16
+	for (unsigned int i = 0; i < size; ++i) {
+		lhs[i] = static_cast<float>(i);
+		rhs[i] = static_cast<float>(i % 8) * 0.5f;
+	}
+
+	GALILEO_TENSOR tensors[4] = {};
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), lhs, GALILEO_BFLOAT16, size, &tensors[0]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), rhs, GALILEO_BFLOAT16, size, &tensors[1]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), sum, GALILEO_BFLOAT16, size, &tensors[2]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), exp, GALILEO_FLOAT, size, &tensors[3]), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	ASSERT_EQ(GALILEO_Add(&tensors[0], &tensors[1], &tensors[2]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Exp(&tensors[1], &tensors[3]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < size; ++i) {
+		ASSERT_FLOAT_EQ(static_cast<float>(sum[i]), static_cast<float>(bfloat16(static_cast<float>(lhs[i]) + static_cast<float>(rhs[i]))));
+		ASSERT_FLOAT_EQ(exp[i], std::exp(static_cast<float>(rhs[i])));
+	}
+
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), lhs), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), rhs), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), sum), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), exp), GALILEO_RESULT::GALILEO_RESULT_OK);
+}
+
+TEST(PlanTests, RepeatedExecution) {
+	auto queue_ptr = GetQueue();
+	constexpr unsigned int size = 1000;
+	float* lhs = nullptr;
+	float* rhs = nullptr;
+	float* result = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, size, reinterpret_cast<void**>(&lhs)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, size, reinterpret_cast<void**>(&rhs)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, size, reinterpret_cast<void**>(&result)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	std::fill(lhs, lhs + size, 1.f);
+	std::iota(rhs, rhs + size, 0.f);
+
+	GALILEO_TENSOR tensors[3] = {};
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), lhs, GALILEO_FLOAT, size, &tensors[0]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), rhs, GALILEO_FLOAT, size, &tensors[1]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), result, GALILEO_FLOAT, size, &tensors[2]), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	const GALILEO_TENSOR* inputs[] = { &tensors[0], &tensors[1] };
+	GALILEO_PLAN plan = nullptr;
+	ASSERT_EQ(GALILEO_CreatePlan(GALILEO_OP_NEG, inputs, 2, &tensors[2], &plan), GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER);
+	ASSERT_EQ(GALILEO_CreatePlan(GALILEO_OP_ADD, inputs, 2, &tensors[2], &plan), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	// the plan keeps reading the bound tensors, so updated contents are picked up by the next execution
+	for (int iteration = 0; iteration < 3; ++iteration) {
+		ASSERT_EQ(GALILEO_ExecutePlan(plan), GALILEO_RESULT::GALILEO_RESULT_OK);
+		ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+		for (unsigned int i = 0; i < size; ++i)
+			ASSERT_FLOAT_EQ(result[i], static_cast<float>(iteration + 1) + rhs[i]);
+		std::fill(lhs, lhs + size, static_cast<float>(iteration + 2));
+	}
+	ASSERT_EQ(GALILEO_DestroyPlan(plan), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	ASSERT_EQ(GALILEO_CreatePlan(GALILEO_OP_NEG, inputs + 1, 1, &tensors[2], &plan), GALILEO_RESULT::GALILEO_RESULT_OK);
+	GALILEO_EVENT event = nullptr;
+	ASSERT_EQ(GALILEO_ExecutePlanAsync(plan, nullptr, 0, &event), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_WaitEvents(&event, 1), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < size; ++i)
+		ASSERT_FLOAT_EQ(result[i], -rhs[i]);
+	ASSERT_EQ(GALILEO_ReleaseEvent(event), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_DestroyPlan(plan), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	// a captured plan keeps its bound op alive after the plan is destroyed
+	ASSERT_EQ(GALILEO_CreatePlan(GALILEO_OP_ADD, inputs, 2, &tensors[2], &plan), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_BeginCapture(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExecutePlan(plan), GALILEO_RESULT::GALILEO_RESULT_OK);
+	GALILEO_GRAPH graph = nullptr;
+	ASSERT_EQ(GALILEO_EndCapture(queue_ptr.get(), &graph), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_DestroyPlan(plan), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_GraphLaunch(graph), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < size; ++i)
+		ASSERT_FLOAT_EQ(result[i], lhs[i] + rhs[i]);
+
+	// graphs aren't nested, the launch is rejected while the queue is captured
+	ASSERT_EQ(GALILEO_BeginCapture(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_GraphLaunch(graph), GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER);
+	GALILEO_GRAPH outer_graph = nullptr;
+	ASSERT_EQ(GALILEO_EndCapture(queue_ptr.get(), &outer_graph), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ReleaseGraph(outer_graph), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ReleaseGraph(graph), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), lhs), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), rhs), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), result), GALILEO_RESULT::GALILEO_RESULT_OK);
+}
+
+TEST(CaptureTests, LaunchAndUpdatePointer) {
+	auto queue_ptr = GetQueue();
+	constexpr unsigned int size = 1000;
+	float* buffers[4] = {};
+	for (auto& buffer : buffers)
+		ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, size, reinterpret_cast<void**>(&buffer)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	auto [input, temporary, result, other_input] = buffers;
+	std::iota(input, input + size, 0.f);
+	std::iota(other_input, other_input + size, 1000.f);
+
+	GALILEO_TENSOR tensors[3] = {};
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), input, GALILEO_FLOAT, size, &tensors[0]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), temporary, GALILEO_FLOAT, size, &tensors[1]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), result, GALILEO_FLOAT, size, &tensors[2]), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	// nothing runs while capturing, the ops are still validated
+	std::fill(result, result + size, -1.f);
+	ASSERT_EQ(GALILEO_BeginCapture(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_BeginCapture(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER);
+	ASSERT_EQ(GALILEO_Neg(&tensors[0], &tensors[1]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Add(&tensors[0], &tensors[1], &tensors[2]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Mul(&tensors[2], &tensors[0], &tensors[2]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Add(&tensors[0], &tensors[0], &tensors[2]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	GALILEO_GRAPH graph = nullptr;
+	ASSERT_EQ(GALILEO_EndCapture(queue_ptr.get(), &graph), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < size; ++i)
+		ASSERT_FLOAT_EQ(result[i], -1.f);
+
+	// the last op overwrites the result, so it has to run after the others
+	for (int iteration = 0; iteration < 2; ++iteration) {
+		ASSERT_EQ(GALILEO_GraphLaunch(graph), GALILEO_RESULT::GALILEO_RESULT_OK);
+		ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+		for (unsigned int i = 0; i < size; ++i)
+			ASSERT_FLOAT_EQ(result[i], 2.f * input[i]);
+	}
+
+	ASSERT_EQ(GALILEO_GraphUpdatePointer(graph, result, result), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_GraphUpdatePointer(graph, other_input + 1, input), GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER);
+	ASSERT_EQ(GALILEO_GraphUpdatePointer(graph, input, other_input), GALILEO_RESULT::GALILEO_RESULT_OK);
+	GALILEO_EVENT event = nullptr;
+	ASSERT_EQ(GALILEO_GraphLaunchAsync(graph, nullptr, 0, &event), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_WaitEvents(&event, 1), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < size; ++i) {
+		ASSERT_FLOAT_EQ(result[i], 2.f * other_input[i]);
+		ASSERT_FLOAT_EQ(temporary[i], -other_input[i]);
+	}
+	ASSERT_EQ(GALILEO_ReleaseEvent(event), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ReleaseGraph(graph), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	for (auto buffer : buffers)
+		ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), buffer), GALILEO_RESULT::GALILEO_RESULT_OK);
+}
+
+TEST(MultiTests, ManySmallTensors) {
+	auto queue_ptr = GetQueue();
+	constexpr unsigned int count = 100;
+	// sizes vary, including empty tensors, so that the element to tensor lookup crosses uneven boundaries
+	std::vector<unsigned int> sizes(count);
+	for (unsigned int i = 0; i < count; ++i)
+		sizes[i] = i % 7 == 3 ? 0 : i * 13 % 61 + 1;
+	const auto total_size = std::accumulate(sizes.begin(), sizes.end(), 0u);
+
+	float* lhs = nullptr;
+	float* rhs = nullptr;
+	float* result = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, total_size, reinterpret_cast<void**>(&lhs)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, total_size, reinterpret_cast<void**>(&rhs)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, total_size, reinterpret_cast<void**>(&result)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	std::iota(lhs, lhs + total_size, 0.f);
+	std::iota(rhs, rhs + total_size, 1.f);
+
+	std::vector<GALILEO_TENSOR> lhs_tensors(count);
+	std::vector<GALILEO_TENSOR> rhs_tensors(count);
+	std::vector<GALILEO_TENSOR> result_tensors(count);
+	for (unsigned int i = 0, offset = 0; i < count; offset += sizes[i++]) {
+		ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), lhs + offset, GALILEO_FLOAT, sizes[i], &lhs_tensors[i]), GALILEO_RESULT::GALILEO_RESULT_OK);
+		ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), rhs + offset, GALILEO_FLOAT, sizes[i], &rhs_tensors[i]), GALILEO_RESULT::GALILEO_RESULT_OK);
+		ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), result + offset, GALILEO_FLOAT, sizes[i], &result_tensors[i]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	}
+
+	ASSERT_EQ(GALILEO_UnaryMulti(GALILEO_OP_ADD, lhs_tensors.data(), result_tensors.data(), count), GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER);
+	ASSERT_EQ(GALILEO_BinaryMulti(GALILEO_OP_MUL, lhs_tensors.data(), rhs_tensors.data(), result_tensors.data(), count), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < total_size; ++i)
+		ASSERT_FLOAT_EQ(result[i], lhs[i] * rhs[i]);
+
+	ASSERT_EQ(GALILEO_UnaryMulti(GALILEO_OP_SQRT, lhs_tensors.data(), result_tensors.data(), count), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < total_size; ++i)
+		ASSERT_FLOAT_EQ(result[i], std::sqrt(lhs[i]));
+
+	// every set has to match the data types of the first one
+	auto mismatched_tensor = result_tensors[count - 1];
+	mismatched_tensor.data_type = GALILEO_INT32;
+	std::swap(mismatched_tensor, result_tensors[count - 1]);
+	ASSERT_EQ(GALILEO_UnaryMulti(GALILEO_OP_SQRT, lhs_tensors.data(), result_tensors.data(), count), GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE);
+
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), lhs), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), rhs), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), result), GALILEO_RESULT::GALILEO_RESULT_OK);
+}
+
+TEST(WarmupTests, Statistics) {
+	auto queue_ptr = GetQueue();
+	GALILEO_WARMUP_STATISTICS statistics = {};
+	ASSERT_EQ(GALILEO_GetWarmupStatistics(queue_ptr.get(), &statistics), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(statistics.kernels, 0);
+
+	// sqrt is floating-point only, the integer type is skipped
+	const auto op_mask = (1ull << GALILEO_OP_SQRT) | (1ull << GALILEO_OP_ADD);
+	const auto type_mask = (1u << GALILEO_FLOAT) | (1u << GALILEO_INT32);
+	ASSERT_EQ(GALILEO_Warmup(queue_ptr.get(), op_mask, type_mask), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_GetWarmupStatistics(queue_ptr.get(), &statistics), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(statistics.kernels, 3);
+	ASSERT_EQ(statistics.skipped, 1);
+	ASSERT_GT(statistics.milliseconds, 0.);
+
+	// int8 operands are added into an int32 output
+	ASSERT_EQ(GALILEO_Warmup(queue_ptr.get(), 1ull << GALILEO_OP_ADD, 1u << GALILEO_INT8), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_GetWarmupStatistics(queue_ptr.get(), &statistics), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(statistics.kernels, 4);
+	ASSERT_EQ(statistics.skipped, 1);
+}
+
+TEST(TypeTests, BinaryOutputFollowsPromotion) {
+	auto queue_ptr = GetQueue();
+	constexpr unsigned int size = 100;
+	std::int8_t* input = nullptr;
+	std::int8_t* narrow_result = nullptr;
+	std::int32_t* result = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT8, size, reinterpret_cast<void**>(&input)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT8, size, reinterpret_cast<void**>(&narrow_result)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT32, size, reinterpret_cast<void**>(&result)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < size; ++i)
+		input[i] = static_cast<std::int8_t>(i);
+
+	GALILEO_TENSOR tensors[3] = {};
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), input, GALILEO_INT8, size, &tensors[0]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), narrow_result, GALILEO_INT8, size, &tensors[1]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), result, GALILEO_INT32, size, &tensors[2]), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	// 8-bit operands are promoted, so the sum is only written to a 32-bit output
+	ASSERT_EQ(GALILEO_Add(&tensors[0], &tensors[0], &tensors[1]), GALILEO_RESULT::GALILEO_RESULT_UNEXPECTED_DATA_TYPE);
+	ASSERT_EQ(GALILEO_Add(&tensors[0], &tensors[0], &tensors[2]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < size; ++i)
+		ASSERT_EQ(result[i], 2 * static_cast<std::int32_t>(i));
+
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), input), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), narrow_result), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), result), GALILEO_RESULT::GALILEO_RESULT_OK);
+}
+
+TEST(ShardTests, ElementwiseAndFullReduction) {
+	// devices without NUMA sub-devices fall back to a single queue, the results are the same either way
+	auto queue_ptr = GetShardedQueue(GALILEO_SHARDING_NUMA);
+	unsigned int shards = 0;
+	ASSERT_EQ(GALILEO_GetShardCount(queue_ptr.get(), &shards), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_GE(shards, 1u);
+
+	constexpr unsigned int size = 1 << 21;
+	std::int32_t* input = nullptr;
+	std::int32_t* output = nullptr;
+	std::int32_t* sum = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT32, size, reinterpret_cast<void**>(&input)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT32, size, reinterpret_cast<void**>(&output)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT32, 1, reinterpret_cast<void**>(&sum)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < size; ++i)
+		input[i] = static_cast<std::int32_t>(i % 7);
+
+	GALILEO_TENSOR tensors[3] = {};
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), input, GALILEO_INT32, size, &tensors[0]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), output, GALILEO_INT32, size, &tensors[1]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), sum, GALILEO_INT32, 1, &tensors[2]), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	ASSERT_EQ(GALILEO_Add(&tensors[0], &tensors[0], &tensors[1]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Sum(&tensors[1], GALILEO_REDUCE_ALL_AXES, &tensors[2]), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	std::int64_t expected = 0;
+	for (unsigned int i = 0; i < size; ++i) {
+		ASSERT_EQ(output[i], 2 * input[i]);
+		expected += output[i];
+	}
+	ASSERT_EQ(*sum, expected);
+
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), input), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), output), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), sum), GALILEO_RESULT::GALILEO_RESULT_OK);
+}
+
+TEST(ProfilingTests, StatsAndTrace) {
+	auto queue_ptr = GetQueue();
+	constexpr unsigned int size = 1000;
+	float* data = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, size, reinterpret_cast<void**>(&data)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	std::fill(data, data + size, 4.f);
+	GALILEO_TENSOR tensor = {};
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), data, GALILEO_FLOAT, size, &tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	ASSERT_EQ(GALILEO_SetProfiling(queue_ptr.get(), 1), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ResetStats(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Add(&tensor, &tensor, &tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Add(&tensor, &tensor, &tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Sqrt(&tensor, &tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	unsigned int count = 0;
+	ASSERT_EQ(GALILEO_GetStats(queue_ptr.get(), nullptr, &count), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(count, 2u);
+	std::vector<GALILEO_OP_STATISTICS> statistics(count);
+	ASSERT_EQ(GALILEO_GetStats(queue_ptr.get(), statistics.data(), &count), GALILEO_RESULT::GALILEO_RESULT_OK);
+	const auto add = std::find_if(statistics.begin(), statistics.end(), [](const auto& entry) { return std::strcmp(entry.name, "Add") == 0; });
+	ASSERT_NE(add, statistics.end());
+	ASSERT_EQ(add->data_type, GALILEO_FLOAT);
+	ASSERT_EQ(add->calls, 2u);
+	ASSERT_EQ(add->bytes, 2ull * 3 * size * sizeof(float));
+	ASSERT_EQ(std::accumulate(std::begin(add->host_histogram), std::end(add->host_histogram), 0ull), 2u);
+
+	const auto path = std::filesystem::temp_directory_path() / "galileo_trace.json";
+	ASSERT_EQ(GALILEO_WriteTrace(queue_ptr.get(), path.string().c_str()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	std::ifstream trace(path);
+	const std::string contents((std::istreambuf_iterator<char>(trace)), std::istreambuf_iterator<char>());
+	ASSERT_NE(contents.find("\"traceEvents\""), std::string::npos);
+	ASSERT_NE(contents.find("\"name\":\"Sqrt\""), std::string::npos);
+	trace.close();
+	std::filesystem::remove(path);
+
+	// disabled queues keep the recorded calls but record no new ones
+	ASSERT_EQ(GALILEO_SetProfiling(queue_ptr.get(), 0), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Add(&tensor, &tensor, &tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_GetStats(queue_ptr.get(), statistics.data(), &count), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(add->calls, 2u);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), data), GALILEO_RESULT::GALILEO_RESULT_OK);
+}
+
+TEST(ProfilingTests, CompositeCalls) {
+	auto queue_ptr = GetQueue();
+	constexpr unsigned int size = 1000;
+	float* data = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, size, reinterpret_cast<void**>(&data)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	std::fill(data, data + size, 4.f);
+	GALILEO_TENSOR tensor = {};
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), data, GALILEO_FLOAT, size, &tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	const GALILEO_TENSOR* inputs[] = { &tensor, &tensor };
+	GALILEO_PLAN plan = nullptr;
+	ASSERT_EQ(GALILEO_CreatePlan(GALILEO_OP_ADD, inputs, 2, &tensor, &plan), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_BeginCapture(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Sqrt(&tensor, &tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	GALILEO_GRAPH graph = nullptr;
+	ASSERT_EQ(GALILEO_EndCapture(queue_ptr.get(), &graph), GALILEO_RESULT::GALILEO_RESULT_OK);
+	GALILEO_EXPRESSION expression = nullptr;
+	GALILEO_EXPRESSION_NODE input = 0, sqrt = 0;
+	ASSERT_EQ(GALILEO_CreateExpression(queue_ptr.get(), &expression), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionInput(expression, &tensor, &input), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionUnary(expression, GALILEO_OP_SQRT, input, &sqrt), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionOutput(expression, sqrt, &tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	// the composite calls are recorded once each, covering every command they submit
+	ASSERT_EQ(GALILEO_SetProfiling(queue_ptr.get(), 1), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ResetStats(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_UnaryMulti(GALILEO_OP_SQRT, &tensor, &tensor, 1), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExecutePlan(plan), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_GraphLaunch(graph), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionEvaluate(expression), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	unsigned int count = 0;
+	ASSERT_EQ(GALILEO_GetStats(queue_ptr.get(), nullptr, &count), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(count, 4u);
+	std::vector<GALILEO_OP_STATISTICS> statistics(count);
+	ASSERT_EQ(GALILEO_GetStats(queue_ptr.get(), statistics.data(), &count), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (const auto* name : { "SqrtMulti", "Plan", "Graph", "Expression" }) {
+		const auto entry = std::find_if(statistics.begin(), statistics.end(), [&](const auto& entry) { return std::strcmp(entry.name, name) == 0; });
+		ASSERT_NE(entry, statistics.end()) << name;
+		ASSERT_EQ(entry->data_type, GALILEO_FLOAT);
+		ASSERT_EQ(entry->calls, 1u);
+	}
+	const auto plan_entry = std::find_if(statistics.begin(), statistics.end(), [](const auto& entry) { return std::strcmp(entry.name, "Plan") == 0; });
+	ASSERT_EQ(plan_entry->bytes, 3ull * size * sizeof(float));
+
+	ASSERT_EQ(GALILEO_SetProfiling(queue_ptr.get(), 0), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ReleaseExpression(expression), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ReleaseGraph(graph), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_DestroyPlan(plan), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), data), GALILEO_RESULT::GALILEO_RESULT_OK);
+}
+
+TEST(HostFastPathTests, SmallOpsRunInlineAfterPendingWork) {
+	unsigned int count = 0;
+	ASSERT_EQ(GALILEO_EnumerateDevices(nullptr, &count), GALILEO_RESULT::GALILEO_RESULT_OK);
+	std::vector<GALILEO_DEVICE_INFO> devices(count);
+	ASSERT_EQ(GALILEO_EnumerateDevices(devices.data(), &count), GALILEO_RESULT::GALILEO_RESULT_OK);
+	if (std::none_of(devices.begin(), devices.end(), [](const auto& device) { return device.device_type == GALILEO_DEVICE_CPU; }))
+		GTEST_SKIP() << "no CPU device";
+
+	unsigned int queue_size = 0;
+	ASSERT_EQ(GALILEO_GetQueueSize(&queue_size), GALILEO_RESULT::GALILEO_RESULT_OK);
+	auto queue_ptr = std::unique_ptr<std::byte[], std::function<GALILEO_RESULT(GALILEO_QUEUE)>>(new std::byte[queue_size], GALILEO_ReleaseQueue);
+	GALILEO_QUEUE_PROPERTIES properties = {};
+	properties.device_type = GALILEO_DEVICE_CPU;
+	ASSERT_EQ(GALILEO_InitQueueEx(queue_ptr.get(), &properties), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_SetHostThreshold(queue_ptr.get(), 256), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	constexpr unsigned int size = 1 << 20;
+	constexpr unsigned int small_size = 256;
+	float* data = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, size, reinterpret_cast<void**>(&data)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	std::fill(data, data + size, 1.f);
+	GALILEO_TENSOR tensor = {};
+	GALILEO_TENSOR small_tensor = {};
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), data, GALILEO_FLOAT, size, &tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), data, GALILEO_FLOAT, small_size, &small_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	// the small op depends on the pending large one and is ordered after it
+	GALILEO_EVENT large_event = nullptr;
+	ASSERT_EQ(GALILEO_AddAsync(&tensor, &tensor, &tensor, nullptr, 0, &large_event), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_AddAsync(&small_tensor, &small_tensor, &small_tensor, &large_event, 1, nullptr), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ReleaseEvent(large_event), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < small_size; ++i)
+		ASSERT_FLOAT_EQ(data[i], 4.f);
+	ASSERT_FLOAT_EQ(data[small_size], 2.f);
+
+	// with nothing pending the result is there as soon as the call returns
+	ASSERT_EQ(GALILEO_Sqrt(&small_tensor, &small_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (unsigned int i = 0; i < small_size; ++i)
+		ASSERT_FLOAT_EQ(data[i], 2.f);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), data), GALILEO_RESULT::GALILEO_RESULT_OK);
+}
+
+TEST(StreamTests, ChunkedFilePipeline) {
+	auto queue_ptr = GetQueue();
+	// a partial last chunk and more chunks than slots
+	constexpr unsigned int size = 10007;
+	std::vector<float> lhs(size);
+	std::vector<float> rhs(size);
+	for (unsigned int i = 0; i < size; ++i) {
+		lhs[i] = static_cast<float>(i % 100);
+		rhs[i] = 0.5f;
+	}
+	const auto directory = std::filesystem::temp_directory_path();
+	const std::string paths[] = { (directory / "galileo_lhs.bin").string(), (directory / "galileo_rhs.bin").string(), (directory / "galileo_out.bin").string() };
+	std::ofstream(paths[0], std::ios::binary).write(reinterpret_cast<const char*>(lhs.data()), size * sizeof(float));
+	std::ofstream(paths[1], std::ios::binary).write(reinterpret_cast<const char*>(rhs.data()), size * sizeof(float));
+
+	// the tensors of the expression only pick the data types of the files
+	float* ptr = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_FLOAT, 1, reinterpret_cast<void**>(&ptr)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	GALILEO_TENSOR tensor = {};
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), ptr, GALILEO_FLOAT, 1, &tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	GALILEO_EXPRESSION expression = nullptr;
+	ASSERT_EQ(GALILEO_CreateExpression(queue_ptr.get(), &expression), GALILEO_RESULT::GALILEO_RESULT_OK);
+	GALILEO_EXPRESSION_NODE a = 0, b = 0, add = 0, mul = 0;
+	ASSERT_EQ(GALILEO_ExpressionInput(expression, &tensor, &a), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionInput(expression, &tensor, &b), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionBinary(expression, GALILEO_OP_ADD, a, b, &add), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionBinary(expression, GALILEO_OP_MUL, add, a, &mul), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionOutput(expression, mul, &tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	const char* input_paths[] = { paths[0].c_str(), paths[1].c_str() };
+	const char* output_paths[] = { paths[2].c_str() };
+	GALILEO_STREAM_PROPERTIES properties = {};
+	properties.chunk_elements = 1000;
+	properties.queue_depth = 3;
+	ASSERT_EQ(GALILEO_StreamExpression(expression, input_paths, output_paths, &properties), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	ASSERT_EQ(std::filesystem::file_size(paths[2]), size * sizeof(float));
+	std::vector<float> output(size);
+	std::ifstream(paths[2], std::ios::binary).read(reinterpret_cast<char*>(output.data()), size * sizeof(float));
+	for (unsigned int i = 0; i < size; ++i)
+		ASSERT_FLOAT_EQ(output[i], (lhs[i] + rhs[i]) * lhs[i]);
+
+	// streaming leaves the expression bound to its own tensors
+	*ptr = 3.f;
+	ASSERT_EQ(GALILEO_ExpressionEvaluate(expression), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_FLOAT_EQ(*ptr, 18.f);
+
+	// a promoted input goes through a scratch block, which the chunks in flight take turns at
+	std::vector<std::int16_t> counts(size);
+	for (unsigned int i = 0; i < size; ++i)
+		counts[i] = static_cast<std::int16_t>(i % 1000 - 500);
+	std::ofstream(paths[1], std::ios::binary).write(reinterpret_cast<const char*>(counts.data()), size * sizeof(std::int16_t));
+	std::int16_t* count_ptr = nullptr;
+	ASSERT_EQ(GALILEO_Allocate(queue_ptr.get(), GALILEO_INT16, 1, reinterpret_cast<void**>(&count_ptr)), GALILEO_RESULT::GALILEO_RESULT_OK);
+	GALILEO_TENSOR count_tensor = {};
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), count_ptr, GALILEO_INT16, 1, &count_tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	GALILEO_EXPRESSION promoted_expression = nullptr;
+	ASSERT_EQ(GALILEO_CreateExpression(queue_ptr.get(), &promoted_expression), GALILEO_RESULT::GALILEO_RESULT_OK);
+	GALILEO_EXPRESSION_NODE c = 0;
+	ASSERT_EQ(GALILEO_ExpressionInput(promoted_expression, &tensor, &a), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionInput(promoted_expression, &count_tensor, &c), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionBinary(promoted_expression, GALILEO_OP_ADD, a, c, &add), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionBinary(promoted_expression, GALILEO_OP_MUL, add, a, &mul), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ExpressionOutput(promoted_expression, mul, &tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_StreamExpression(promoted_expression, input_paths, output_paths, &properties), GALILEO_RESULT::GALILEO_RESULT_OK);
+	std::ifstream(paths[2], std::ios::binary).read(reinterpret_cast<char*>(output.data()), size * sizeof(float));
+	for (unsigned int i = 0; i < size; ++i)
+		ASSERT_FLOAT_EQ(output[i], (lhs[i] + counts[i]) * lhs[i]);
+
+	ASSERT_EQ(GALILEO_ReleaseExpression(promoted_expression), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), count_ptr), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_ReleaseExpression(expression), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_Deallocate(queue_ptr.get(), ptr), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (const auto& path : paths)
+		std::filesystem::remove(path);
+}
+
+TEST(InfrastructureTests, RegisterHostMemory) {
+	auto queue_ptr = GetQueue();
+	constexpr unsigned int size = 1024;
+	std::vector<float> host_data(size, -2.f);
+
+	GALILEO_TENSOR tensor = {};
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), host_data.data(), GALILEO_FLOAT, size, &tensor), GALILEO_RESULT::GALILEO_RESULT_NON_USM_POINTER);
+	// only the in-place use is asked for first, a device copy has to be allowed explicitly
+	GALILEO_HOST_MEMORY_MODE mode = GALILEO_HOST_MEMORY_IMPORTED;
+	const auto import_result = GALILEO_RegisterHostMemory(queue_ptr.get(), host_data.data(), size * sizeof(float), &mode);
+	if (import_result == GALILEO_RESULT::GALILEO_RESULT_NON_USM_POINTER) {
+		ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), host_data.data(), GALILEO_FLOAT, size, &tensor), GALILEO_RESULT::GALILEO_RESULT_NON_USM_POINTER);
+		mode = GALILEO_HOST_MEMORY_MIRRORED;
+		ASSERT_EQ(GALILEO_RegisterHostMemory(queue_ptr.get(), host_data.data(), size * sizeof(float), &mode), GALILEO_RESULT::GALILEO_RESULT_OK);
+		ASSERT_EQ(mode, GALILEO_HOST_MEMORY_MIRRORED);
+	}
+	else {
+		ASSERT_EQ(import_result, GALILEO_RESULT::GALILEO_RESULT_OK);
+		ASSERT_EQ(mode, GALILEO_HOST_MEMORY_IMPORTED);
+	}
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), host_data.data(), GALILEO_FLOAT, size, &tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(tensor.tensor_data == host_data.data(), mode == GALILEO_HOST_MEMORY_IMPORTED);
+	ASSERT_EQ(GALILEO_Abs(&tensor, &tensor), GALILEO_RESULT::GALILEO_RESULT_OK);
+	ASSERT_EQ(GALILEO_QueueWait(queue_ptr.get()), GALILEO_RESULT::GALILEO_RESULT_OK);
+
+	// an imported range holds the results already, a mirrored one gets them back on unregistering
+	ASSERT_EQ(GALILEO_UnregisterHostMemory(queue_ptr.get(), host_data.data()), GALILEO_RESULT::GALILEO_RESULT_OK);
+	for (auto value : host_data)
+		ASSERT_FLOAT_EQ(value, 2.f);
+	ASSERT_EQ(GALILEO_UnregisterHostMemory(queue_ptr.get(), host_data.data()), GALILEO_RESULT::GALILEO_RESULT_INVALID_FUNC_PARAMETER);
+	ASSERT_EQ(GALILEO_Create1dTensor(queue_ptr.get(), host_data.data(), GALILEO_FLOAT, size, &tensor), GALILEO_RESULT::GALILEO_RESULT_NON_USM_POINTER);
+}